@@ -2,10 +2,7 @@
 
 #include <QGLWidget>
 #include <QMatrix4x4>
-#include <QMouseEvent>
-#include <QKeyEvent>
-#include <QTime>
-#include <QTimer>
+#include <QPoint>
 #include <QVector3D>
 #include <QSet>
 
@@ -65,7 +62,8 @@ private:
     void normalizeAngles();
 };
 
-class KeyboardAndMouseController final : public QObject {
+/* Lives on the render thread, which forwards input to it and moves the camera every frame. */
+class KeyboardAndMouseController final {
 public:
     KeyboardAndMouseController();
     ~KeyboardAndMouseController() = default;
@@ -76,10 +74,13 @@ public:
     KeyboardAndMouseController &operator=(KeyboardAndMouseController &&)      = delete;
 
 
-    void applyKeyPressEvent(QKeyEvent *event);
-    void applyKeyReleaseEvent(QKeyEvent *event);
-    void applyMousePressEvent(QMouseEvent *event);
-    void applyMouseMoveEvent(QMouseEvent *event);
+    void applyKeyPress(int key);
+    void applyKeyRelease(int key);
+    void applyMousePress(const QPoint &position);
+    void applyMouseMove(const QPoint &position);
+
+    /* Moves the camera along the held keys for the given time, at prefs->camera.speed per millisecond. */
+    void update(float elapsedMilliseconds);
 
     void recalculatePerspective(int width, int height);
 
@@ -89,15 +90,9 @@ public:
 
     void setPreferences(const Preferences::Preferences *prefs);
 
-private slots:
-    void updateKeys();
-
 private:
-    Q_OBJECT
-
     Camera camera;
     QSet<qint32> keys;
-    QTimer *timer;
 
     const Preferences::Preferences *prefs;
 };
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <QGLShaderProgram>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
+
+namespace DensityRenderer {
+
+/* Accumulates additively splatted points in a floating-point framebuffer and resolves the
+   accumulated density to the screen with tone mapping in a second pass. */
+class DensityRenderer final {
+public:
+    DensityRenderer() = default;
+    ~DensityRenderer() = default;
+
+    DensityRenderer(const DensityRenderer &)            = delete;
+    DensityRenderer(DensityRenderer &&)                 = delete;
+    DensityRenderer &operator=(const DensityRenderer &) = delete;
+    DensityRenderer &operator=(DensityRenderer &&)      = delete;
+
+    void initialize();
+
+    /* Redirects drawing to the cleared accumulation buffer of the size of the current viewport,
+       with depth testing off and additive blending on. */
+    void startAccumulation();
+
+    /* Restores the framebuffer and the state that were current before startAccumulation and
+       draws the tone-mapped density over the whole viewport. */
+    void resolve(float exposure);
+
+private:
+    void resize(GLsizei newWidth, GLsizei newHeight);
+
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+
+    std::unique_ptr<QGLShaderProgram> resolveProgram;
+    /* Has no attributes, since the full-screen triangle is generated from gl_VertexID. */
+    QOpenGLVertexArrayObject resolveVertexArray;
+
+    /* The RGB sum of the splatted colors and, in alpha, the sum of their weights. */
+    GLuint framebuffer = 0;
+    GLuint densityTexture = 0;
+    GLsizei width = 0;
+    GLsizei height = 0;
+
+    GLint previousFramebuffer = 0;
+    GLint previousViewport[4] = {};
+    GLfloat previousClearColor[4] = {};
+    GLboolean depthTestEnabled = GL_FALSE;
+};
+
+} //namespace DensityRenderer
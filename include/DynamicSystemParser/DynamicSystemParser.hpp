@@ -8,8 +8,7 @@
 
 namespace DynamicSystemParser {
 
-template<typename NewPointAction>
-DynamicSystems::DynamicSystem<NewPointAction> getDynamicSystem(
+DynamicSystems::DynamicSystem getDynamicSystem(
         const std::string &attractorName,
         const std::array<std::string, 3> &formulae,
         const std::vector<std::string> &variablesNames = {},
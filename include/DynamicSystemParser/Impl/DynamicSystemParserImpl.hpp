@@ -19,7 +19,7 @@ public:
                              std::unique_ptr<const Parser::Node> yFunc,
                              std::unique_ptr<const Parser::Node> zFunc);
 
-    auto operator()(std::vector<long double> &) {
+    auto operator()(const std::vector<long double> &) {
         return [&xFuncGet = *xFunc, &yFuncGet = *yFunc, &zFuncGet = *zFunc, &variablesGet = *variables] //TODO
                 (const Model::Point &point) {
             variablesGet[0] = point.x;
@@ -39,18 +39,4 @@ ParserDerivativesWrapper parseExpressions(const std::string &xExpr, const std::s
 
 } // namespace Impl
 
-template<typename NewPointAction>
-DynamicSystems::DynamicSystem<NewPointAction> getDynamicSystem(
-        const std::string &attractorName,
-        const std::array<std::string, 3> &formulae,
-        const std::vector<std::string> &variablesNames,
-        const std::vector<std::pair<std::string, std::vector<long double>>> &interestingConstants,
-        const std::map<std::string, long double> &customConstVariables) {
-    using DynamicSystem = DynamicSystems::DynamicSystem<NewPointAction>;
-    using LambdaDerivatives = decltype(std::declval<Impl::ParserDerivativesWrapper>().operator()(std::declval<std::vector<long double> &>()));
-    using DynamicSystemInternal = DynamicSystems::DynamicSystemInternal<NewPointAction, LambdaDerivatives>;
-    return DynamicSystem{attractorName, formulae, variablesNames, interestingConstants,
-                         DynamicSystemInternal{Impl::parseExpressions(formulae[0], formulae[1], formulae[2], customConstVariables)}};
-}
-
 } // namespace DynamicSystemParser
@@ -1,19 +1,41 @@
 #pragma once
 
-#include <QVector>
-#include <QVector3D>
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include "Model/Model.hpp"
+#include "DynamicSystems/DynamicSystem.hpp"
+#include "TrajectoryBuffer.hpp"
 
 namespace DynamicSystemWrapper_n {
 
-inline auto getPushBackAndNormalizeLambda(QVector<QVector3D> &vector, float normalizeConstant) {
-    return [&vector, normalizeConstant](const Model::Point &point) {
-        vector.push_back(
-                QVector3D(static_cast<float>(point.x) / normalizeConstant,
-                          static_cast<float>(point.y) / normalizeConstant,
-                          static_cast<float>(point.z) / normalizeConstant)
-        );
-    };
+/* Integrates up to pointsCount points block by block straight into the buffer, continuing
+   from point. Returns the number of points appended, as DynamicSystem::computeBlock does. */
+inline int computeNormalized(const DynamicSystems::DynamicSystem &system,
+                             TrajectoryBuffer::TrajectoryBuffer &buffer,
+                             Model::Point &point,
+                             int pointsCount,
+                             long double timeDelta,
+                             const std::vector<long double> &constants,
+                             float normalizeConstant) {
+    constexpr int BLOCK_SIZE = DynamicSystems::DynamicSystem::COMPUTE_BLOCK_SIZE;
+
+    pointsCount = static_cast<int>(std::min<size_t>(pointsCount, buffer.capacity() - buffer.size()));
+
+    std::array<Model::Point, BLOCK_SIZE> block;
+    int computed = 0;
+    while (computed < pointsCount) {
+        int requested = std::min(BLOCK_SIZE, pointsCount - computed);
+        int written = system.computeBlock(block.data(), point, requested, timeDelta, constants);
+
+        buffer.append(block.data(), written, normalizeConstant);
+        computed += written;
+        if (written < requested) {
+            break;
+        }
+    }
+    return computed;
 }
 
-}
\ No newline at end of file
+}
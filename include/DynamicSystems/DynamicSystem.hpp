@@ -12,15 +12,12 @@
 namespace DynamicSystems {
 
 
-template<typename LambdaNewPointAction>
 class DynamicSystem;
 
 
-template<typename LambdaNewPointAction>
-std::vector<DynamicSystem<LambdaNewPointAction>> getDefaultSystems();
+std::vector<DynamicSystem> getDefaultSystems();
 
 
-template<typename LambdaNewPointAction>
 class DynamicSystem final {
 public:
     template<typename LambdaDerivatives>
@@ -28,7 +25,7 @@ public:
                   std::array<std::string, 3> formulae,
                   std::vector<std::string> variablesNames,
                   std::vector<std::pair<std::string, std::vector<long double>>> interestingConstants,
-                  DynamicSystemInternal<LambdaNewPointAction, LambdaDerivatives> systemInternal);
+                  DynamicSystemInternal<LambdaDerivatives> systemInternal);
 
 
     std::string_view getAttractorName() const;
@@ -41,11 +38,24 @@ public:
 
     const std::vector<std::pair<std::string, std::vector<long double>>> &getInterestingConstants() const;
 
-    const std::function<void(LambdaNewPointAction &&newPointAction,
-                             Model::Point point,
-                             int pointsCount,
-                             long double timeDelta,
-                             std::vector<long double> &constantValues)> compute;
+    /* Integrates up to pointsCount steps into points, continuing from point and leaving it
+       at the last computed state. Returns the number of points written: fewer than requested
+       means the trajectory has left the model bounds. */
+    const std::function<int(Model::Point *points,
+                            Model::Point &point,
+                            int pointsCount,
+                            long double timeDelta,
+                            const std::vector<long double> &constantValues)> computeBlock;
+
+    /* Per-point adapter over computeBlock. */
+    template<typename LambdaNewPointAction>
+    void compute(LambdaNewPointAction &&newPointAction,
+                 Model::Point point,
+                 int pointsCount,
+                 long double timeDelta,
+                 const std::vector<long double> &constantValues) const;
+
+    constexpr static int COMPUTE_BLOCK_SIZE = 512;
 
 private:
     const std::string attractorName_;
@@ -58,4 +68,4 @@ private:
 } // namespace DynamicSystem
 
 #include "DynamicSystems/Impl/DynamicSystemImpl.hpp"
-#include "DynamicSystems/SystemsBase/SystemsBaseGetImpl.hpp"
\ No newline at end of file
+#include "DynamicSystems/SystemsBase/SystemsBaseGetImpl.hpp"
@@ -4,6 +4,7 @@
 #include <string>
 #include <array>
 #include <utility>
+#include <algorithm>
 
 #include "Model/Model.hpp"
 #include "DynamicSystems/DynamicSystem.hpp"
@@ -12,22 +13,20 @@
 namespace DynamicSystems {
 
 
-template<typename LambdaNewPointAction>
 template<typename LambdaDerivatives>
-DynamicSystem<LambdaNewPointAction>::DynamicSystem(
+DynamicSystem::DynamicSystem(
         std::string attractorName,
         std::array<std::string, 3> formulae,
         std::vector<std::string> variablesNames,
         std::vector<std::pair<std::string, std::vector<long double>>> interestingConstants,
-        DynamicSystemInternal<LambdaNewPointAction, LambdaDerivatives> systemInternal) :
-        compute{
-                [system = std::move(systemInternal)](LambdaNewPointAction &&newPointAction,
-                                                     Model::Point point,
+        DynamicSystemInternal<LambdaDerivatives> systemInternal) :
+        computeBlock{
+                [system = std::move(systemInternal)](Model::Point *points,
+                                                     Model::Point &point,
                                                      int pointsCount,
                                                      long double timeDelta,
-                                                     std::vector<long double> &variableValue) {
-                    system.compute(std::forward<LambdaNewPointAction>(newPointAction),
-                                   point, pointsCount, timeDelta, variableValue);
+                                                     const std::vector<long double> &constantValues) {
+                    return system.compute(points, point, pointsCount, timeDelta, constantValues);
                 }
         },
         attractorName_{std::move(attractorName)},
@@ -37,17 +36,35 @@ DynamicSystem<LambdaNewPointAction>::DynamicSystem(
 
 
 template<typename LambdaNewPointAction>
-std::string_view DynamicSystem<LambdaNewPointAction>::getAttractorName() const {
+void DynamicSystem::compute(LambdaNewPointAction &&newPointAction,
+                            Model::Point point,
+                            int pointsCount,
+                            long double timeDelta,
+                            const std::vector<long double> &constantValues) const {
+    std::array<Model::Point, COMPUTE_BLOCK_SIZE> block;
+    while (pointsCount > 0) {
+        int requested = std::min(pointsCount, COMPUTE_BLOCK_SIZE);
+        int written = computeBlock(block.data(), point, requested, timeDelta, constantValues);
+        for (int i = 0; i < written; i++) {
+            newPointAction(block[i]);
+        }
+        if (written < requested) {
+            break;
+        }
+        pointsCount -= written;
+    }
+}
+
+
+inline std::string_view DynamicSystem::getAttractorName() const {
     return attractorName_;
 }
 
-template<typename LambdaNewPointAction>
-std::array<std::string_view, 3> DynamicSystem<LambdaNewPointAction>::getFormulae() const {
+inline std::array<std::string_view, 3> DynamicSystem::getFormulae() const {
     return {formulae_[0], formulae_[1], formulae_[2]};
 }
 
-template<typename LambdaNewPointAction>
-std::vector<std::string_view> DynamicSystem<LambdaNewPointAction>::getVariablesNames() const {
+inline std::vector<std::string_view> DynamicSystem::getVariablesNames() const {
     std::vector<std::string_view> variablesNamesView;
     for (auto &varName : variablesNames_) {
         variablesNamesView.push_back(varName);
@@ -55,16 +72,14 @@ std::vector<std::string_view> DynamicSystem<LambdaNewPointAction>::getVariablesN
     return variablesNamesView;
 }
 
-template<typename LambdaNewPointAction>
-std::size_t DynamicSystem<LambdaNewPointAction>::constantsCount() const {
+inline std::size_t DynamicSystem::constantsCount() const {
     return variablesNames_.size();
 }
 
-template<typename LambdaNewPointAction>
-const std::vector<std::pair<std::string, std::vector<long double>>> &
-DynamicSystem<LambdaNewPointAction>::getInterestingConstants() const {
+inline const std::vector<std::pair<std::string, std::vector<long double>>> &
+DynamicSystem::getInterestingConstants() const {
     return interestingConstants_;
 }
 
 
-} // namespace DynamicSystem
\ No newline at end of file
+} // namespace DynamicSystem
@@ -10,26 +10,25 @@
 namespace DynamicSystems {
 
 
-template<typename LambdaNewPointAction, typename LambdaDerivatives>
+template<typename LambdaDerivatives>
 class DynamicSystemInternal final {
 public:
     explicit DynamicSystemInternal(
-            std::function<LambdaDerivatives(std::vector<long double> &)> derivativesFunctionGetter) :
+            std::function<LambdaDerivatives(const std::vector<long double> &)> derivativesFunctionGetter) :
             getDerivativesFunction{std::move(derivativesFunctionGetter)} {}
 
-    void compute(LambdaNewPointAction &&newPointAction,
-                 Model::Point point,
-                 int pointsCount,
-                 long double timeDelta,
-                 std::vector<long double> &constantValues) const {
-        Model::generatePoints(std::forward<LambdaNewPointAction>(newPointAction),
-                              point, pointsCount, timeDelta,
-                              getDerivativesFunction(constantValues));
+    int compute(Model::Point *points,
+                Model::Point &point,
+                int pointsCount,
+                long double timeDelta,
+                const std::vector<long double> &constantValues) const {
+        return Model::generatePointsBlock(points, point, pointsCount, timeDelta,
+                                          getDerivativesFunction(constantValues));
     }
 
 private:
-    const std::function<LambdaDerivatives(std::vector<long double> &)> getDerivativesFunction;
+    const std::function<LambdaDerivatives(const std::vector<long double> &)> getDerivativesFunction;
 };
 
 
-} // namespace DynamicSystem
\ No newline at end of file
+} // namespace DynamicSystem
@@ -11,8 +11,7 @@
 namespace DynamicSystems::AllSystems {
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemLorenz() {
+inline DynamicSystem getSystemLorenz() {
     std::string attractorName = "The Lorenz attractor";
     std::array<std::string, 3> formulae = {"a*(y - x)",
                                            "x*(r - z) - y",
@@ -32,13 +31,12 @@ DynamicSystem<LambdaNewPointAction> getSystemLorenz() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemRossler() {
+inline DynamicSystem getSystemRossler() {
     std::string attractorName = "The Rossler attractor";
     std::array<std::string, 3> formulae = {"-z - x",
                                            "x + a*y",
@@ -59,13 +57,12 @@ DynamicSystem<LambdaNewPointAction> getSystemRossler() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemChua() {
+inline DynamicSystem getSystemChua() {
     std::string attractorName = "The Chua attractor";
     std::array<std::string, 3> formulae = {
             "s*(y - x - (c*x + 0.5*(b - c)(|x + d| - |x - d|) + 0.5*(a - b)(|x + 1| - |x - 1|)))",
@@ -91,13 +88,12 @@ DynamicSystem<LambdaNewPointAction> getSystemChua() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemHR3() {
+inline DynamicSystem getSystemHR3() {
     std::string attractorName = "The Hindmarsh-Rose system";
     std::array<std::string, 3> formulae = {"y - a*x^3 + b*x^2 - z + I",
                                            "c - d*x^2 - y",
@@ -117,13 +113,12 @@ DynamicSystem<LambdaNewPointAction> getSystemHR3() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemAizawa() {
+inline DynamicSystem getSystemAizawa() {
     std::string attractorName = "The Aizawa attractor";
     std::array<std::string, 3> formulae = {"(z - b)*x - d*y",
                                            "d*x + (z - b)*y",
@@ -145,13 +140,12 @@ DynamicSystem<LambdaNewPointAction> getSystemAizawa() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemChenLee() {
+inline DynamicSystem getSystemChenLee() {
     std::string attractorName = "The Chen-Lee attractor";
     std::array<std::string, 3> formulae = {"a*x - y*z",
                                            "b*y + x*z",
@@ -171,13 +165,12 @@ DynamicSystem<LambdaNewPointAction> getSystemChenLee() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemAnishenkoAstakhov() {
+inline DynamicSystem getSystemAnishenkoAstakhov() {
     std::string attractorName = "The Anishenko-Astakhov attractor";
     std::array<std::string, 3> formulae = {"x*(a - z) + y",
                                            "-x",
@@ -196,13 +189,12 @@ DynamicSystem<LambdaNewPointAction> getSystemAnishenkoAstakhov() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemBouali2() {
+inline DynamicSystem getSystemBouali2() {
     std::string attractorName = "The second Bouali attractor";
     std::array<std::string, 3> formulae = {"x*(4 - y) + a*z",
                                            "-y*(1 - x^2)",
@@ -221,13 +213,12 @@ DynamicSystem<LambdaNewPointAction> getSystemBouali2() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemBurkeShaw() {
+inline DynamicSystem getSystemBurkeShaw() {
     std::string attractorName = "The Burke-Shaw attractor";
     std::array<std::string, 3> formulae = {"-a*(x + y)",
                                            "-y - a*x*z",
@@ -246,13 +237,12 @@ DynamicSystem<LambdaNewPointAction> getSystemBurkeShaw() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemChenCelikovsky() {
+inline DynamicSystem getSystemChenCelikovsky() {
     std::string attractorName = "The Chen-Celikovsky attractor";
     std::array<std::string, 3> formulae = {"a*(y - x)",
                                            "-x*z + c*y",
@@ -272,14 +262,13 @@ DynamicSystem<LambdaNewPointAction> getSystemChenCelikovsky() {
     };
     return {
             attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}
     };
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemCoullet() {
+inline DynamicSystem getSystemCoullet() {
     std::string attractorName = "The Collet attractor";
     std::array<std::string, 3> formulae = {"y",
                                            "z",
@@ -299,13 +288,12 @@ DynamicSystem<LambdaNewPointAction> getSystemCoullet() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemDadras() {
+inline DynamicSystem getSystemDadras() {
     std::string attractorName = "The Dadras attractor";
     std::array<std::string, 3> formulae = {"y - a*x + b*y*z",
                                            "c*y - x*z + z",
@@ -325,13 +313,12 @@ DynamicSystem<LambdaNewPointAction> getSystemDadras() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemDequanLi() {
+inline DynamicSystem getSystemDequanLi() {
     std::string attractorName = "The Dequan Li attractor";
     std::array<std::string, 3> formulae = {"a*(y - z) + c*x*z",
                                            "f*x + g*y - x*z",
@@ -351,13 +338,12 @@ DynamicSystem<LambdaNewPointAction> getSystemDequanLi() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemFinance() {
+inline DynamicSystem getSystemFinance() {
     std::string attractorName = "The Finance attractor";
     std::array<std::string, 3> formulae = {"(1/b - a)*x + z + x*y",
                                            "-b*y - x^2",
@@ -377,13 +363,12 @@ DynamicSystem<LambdaNewPointAction> getSystemFinance() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemFourWing() {
+inline DynamicSystem getSystemFourWing() {
     std::string attractorName = "The Four-Wing attractor";
     std::array<std::string, 3> formulae = {"a*x - b*y*z",
                                            "c*y + x*z",
@@ -403,13 +388,12 @@ DynamicSystem<LambdaNewPointAction> getSystemFourWing() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemGenesioTesi() {
+inline DynamicSystem getSystemGenesioTesi() {
     std::string attractorName = "The Genesio-Tesi attractor";
     std::array<std::string, 3> formulae = {"y",
                                            "z",
@@ -428,13 +412,12 @@ DynamicSystem<LambdaNewPointAction> getSystemGenesioTesi() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemHadley() {
+inline DynamicSystem getSystemHadley() {
     std::string attractorName = "The Hadley attractor";
     std::array<std::string, 3> formulae = {"-y^2 - z^2 - a*x + a*c",
                                            "x*y - b*x*y - y + d",
@@ -454,13 +437,12 @@ DynamicSystem<LambdaNewPointAction> getSystemHadley() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemHalvorsen() {
+inline DynamicSystem getSystemHalvorsen() {
     std::string attractorName = "The Halvorsen attractor";
     std::array<std::string, 3> formulae = {"-a*x - 4*(y + z) - y^2",
                                            "-a*y - 4*(x + x) - z^2",
@@ -479,13 +461,12 @@ DynamicSystem<LambdaNewPointAction> getSystemHalvorsen() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemLiuChen() {
+inline DynamicSystem getSystemLiuChen() {
     std::string attractorName = "The Liu-Chen attractor";
     std::array<std::string, 3> formulae = {"a*y + b*x + c*y*z",
                                            "d*y - z + f*x*z",
@@ -505,13 +486,12 @@ DynamicSystem<LambdaNewPointAction> getSystemLiuChen() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemLorenzMod1() {
+inline DynamicSystem getSystemLorenzMod1() {
     std::string attractorName = "The Lorenz Mod 1 attractor";
     std::array<std::string, 3> formulae = {"-a*x + y^2 - z^2  + a*c",
                                            "x*(y - b*z) + d",
@@ -531,13 +511,12 @@ DynamicSystem<LambdaNewPointAction> getSystemLorenzMod1() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemLorenzMod2() {
+inline DynamicSystem getSystemLorenzMod2() {
     std::string attractorName = "The Lorenz Mod 2 attractor";
     std::array<std::string, 3> formulae = {"-a*x + y^2 - z^2 + a*c",
                                            "x*(y - b*z) + d",
@@ -557,13 +536,12 @@ DynamicSystem<LambdaNewPointAction> getSystemLorenzMod2() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemLuChen() {
+inline DynamicSystem getSystemLuChen() {
     std::string attractorName = "The Lu-Chen attractor";
     std::array<std::string, 3> formulae = {"(-a*b*x)/(a+b) - y*z + c",
                                            "a*y + x*z",
@@ -583,13 +561,12 @@ DynamicSystem<LambdaNewPointAction> getSystemLuChen() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemNewtonLeipnik() {
+inline DynamicSystem getSystemNewtonLeipnik() {
     std::string attractorName = "The Newton-Leipnik attractor";
     std::array<std::string, 3> formulae = {"-a*x + y + 10*y*z",
                                            "-x - 0.4*y + 5*x*z",
@@ -608,13 +585,12 @@ DynamicSystem<LambdaNewPointAction> getSystemNewtonLeipnik() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemNoseHoover() {
+inline DynamicSystem getSystemNoseHoover() {
     std::string attractorName = "The Nose-Hoover attractor";
     std::array<std::string, 3> formulae = {"y",
                                            "y*z - x",
@@ -633,13 +609,12 @@ DynamicSystem<LambdaNewPointAction> getSystemNoseHoover() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemQiChen() {
+inline DynamicSystem getSystemQiChen() {
     std::string attractorName = "The Qi-Chen attractor";
     std::array<std::string, 3> formulae = {"a*(y - x) + x*z",
                                            "x*(c - z) + y",
@@ -658,13 +633,12 @@ DynamicSystem<LambdaNewPointAction> getSystemQiChen() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemRayleighBenard() {
+inline DynamicSystem getSystemRayleighBenard() {
     std::string attractorName = "The Rayleigh-Benard attractor";
     std::array<std::string, 3> formulae = {"a*(y - x)",
                                            "b*x - y - x*z",
@@ -683,13 +657,12 @@ DynamicSystem<LambdaNewPointAction> getSystemRayleighBenard() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemRucklige() {
+inline DynamicSystem getSystemRucklige() {
     std::string attractorName = "The Rucklige attractor";
     std::array<std::string, 3> formulae = {"-a*x + b*y - y*z",
                                            "x",
@@ -708,13 +681,12 @@ DynamicSystem<LambdaNewPointAction> getSystemRucklige() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemSakaraya() {
+inline DynamicSystem getSystemSakaraya() {
     std::string attractorName = "The Sakaraya attractor";
     std::array<std::string, 3> formulae = {"y - x + y*z",
                                            "-x - y + a*x*z",
@@ -733,13 +705,12 @@ DynamicSystem<LambdaNewPointAction> getSystemSakaraya() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemShimizuMorioka() {
+inline DynamicSystem getSystemShimizuMorioka() {
     std::string attractorName = "The Shimizu-Morioka attractor";
     std::array<std::string, 3> formulae = {"y",
                                            "x*(1 - z) - a*y",
@@ -758,13 +729,12 @@ DynamicSystem<LambdaNewPointAction> getSystemShimizuMorioka() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemThomas() {
+inline DynamicSystem getSystemThomas() {
     std::string attractorName = "The Thomas attractor";
     std::array<std::string, 3> formulae = {"a*x + sin(y)",
                                            "-a*y + sin(z)",
@@ -783,13 +753,12 @@ DynamicSystem<LambdaNewPointAction> getSystemThomas() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemTSUCS1() {
+inline DynamicSystem getSystemTSUCS1() {
     std::string attractorName = "The TSUCS1 attractor";
     std::array<std::string, 3> formulae = {"a*(y - z) + c*x*z",
                                            "f*y - x*z",
@@ -809,13 +778,12 @@ DynamicSystem<LambdaNewPointAction> getSystemTSUCS1() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemTSUCS2() {
+inline DynamicSystem getSystemTSUCS2() {
     std::string attractorName = "The TSUCS2 attractor";
     std::array<std::string, 3> formulae = {"a*(y - z) + d*x*z",
                                            "g*y + b*x - x*z",
@@ -835,13 +803,12 @@ DynamicSystem<LambdaNewPointAction> getSystemTSUCS2() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemWangSun() {
+inline DynamicSystem getSystemWangSun() {
     std::string attractorName = "The Wang-Sun attractor";
     std::array<std::string, 3> formulae = {"a*x + c*y*z",
                                            "b*x + d*y - x*z",
@@ -861,13 +828,12 @@ DynamicSystem<LambdaNewPointAction> getSystemWangSun() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemWimolBanlue() {
+inline DynamicSystem getSystemWimolBanlue() {
     std::string attractorName = "The Wimol-Banlue attractor";
     std::array<std::string, 3> formulae = {"y - x",
                                            "-z*tanh(x)",
@@ -886,13 +852,12 @@ DynamicSystem<LambdaNewPointAction> getSystemWimolBanlue() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
 
-template<typename LambdaNewPointAction>
-DynamicSystem<LambdaNewPointAction> getSystemYuWang() {
+inline DynamicSystem getSystemYuWang() {
     std::string attractorName = "The Yu-Wang attractor";
     std::array<std::string, 3> formulae = {"a*(y - x)",
                                            "b*x - c*x*z",
@@ -912,7 +877,7 @@ DynamicSystem<LambdaNewPointAction> getSystemYuWang() {
         };
     };
     return {attractorName, formulae, constantsNames, interestingConstants,
-            DynamicSystemInternal<LambdaNewPointAction, decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
+            DynamicSystemInternal<decltype(derivativesFunctionGetter(std::declval<std::vector<long double>>()))>
                     {derivativesFunctionGetter}};
 }
 
@@ -9,44 +9,43 @@
 namespace DynamicSystems {
 
 
-template<typename LambdaNewPointAction>
-std::vector<DynamicSystem<LambdaNewPointAction>> getDefaultSystems() {
-    std::vector<DynamicSystem<LambdaNewPointAction>> systemsVector;
-    systemsVector.push_back(AllSystems::getSystemLorenz<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemRossler<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemChua<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemHR3<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemAizawa<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemChenLee<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemAnishenkoAstakhov<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemBouali2<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemBurkeShaw<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemChenCelikovsky<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemCoullet<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemDadras<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemDequanLi<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemFinance<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemFourWing<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemGenesioTesi<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemHadley<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemHalvorsen<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemLiuChen<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemLorenzMod1<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemLorenzMod2<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemLuChen<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemNewtonLeipnik<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemNoseHoover<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemQiChen<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemRayleighBenard<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemRucklige<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemSakaraya<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemShimizuMorioka<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemThomas<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemTSUCS1<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemTSUCS2<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemWangSun<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemWimolBanlue<LambdaNewPointAction>());
-    systemsVector.push_back(AllSystems::getSystemYuWang<LambdaNewPointAction>());
+inline std::vector<DynamicSystem> getDefaultSystems() {
+    std::vector<DynamicSystem> systemsVector;
+    systemsVector.push_back(AllSystems::getSystemLorenz());
+    systemsVector.push_back(AllSystems::getSystemRossler());
+    systemsVector.push_back(AllSystems::getSystemChua());
+    systemsVector.push_back(AllSystems::getSystemHR3());
+    systemsVector.push_back(AllSystems::getSystemAizawa());
+    systemsVector.push_back(AllSystems::getSystemChenLee());
+    systemsVector.push_back(AllSystems::getSystemAnishenkoAstakhov());
+    systemsVector.push_back(AllSystems::getSystemBouali2());
+    systemsVector.push_back(AllSystems::getSystemBurkeShaw());
+    systemsVector.push_back(AllSystems::getSystemChenCelikovsky());
+    systemsVector.push_back(AllSystems::getSystemCoullet());
+    systemsVector.push_back(AllSystems::getSystemDadras());
+    systemsVector.push_back(AllSystems::getSystemDequanLi());
+    systemsVector.push_back(AllSystems::getSystemFinance());
+    systemsVector.push_back(AllSystems::getSystemFourWing());
+    systemsVector.push_back(AllSystems::getSystemGenesioTesi());
+    systemsVector.push_back(AllSystems::getSystemHadley());
+    systemsVector.push_back(AllSystems::getSystemHalvorsen());
+    systemsVector.push_back(AllSystems::getSystemLiuChen());
+    systemsVector.push_back(AllSystems::getSystemLorenzMod1());
+    systemsVector.push_back(AllSystems::getSystemLorenzMod2());
+    systemsVector.push_back(AllSystems::getSystemLuChen());
+    systemsVector.push_back(AllSystems::getSystemNewtonLeipnik());
+    systemsVector.push_back(AllSystems::getSystemNoseHoover());
+    systemsVector.push_back(AllSystems::getSystemQiChen());
+    systemsVector.push_back(AllSystems::getSystemRayleighBenard());
+    systemsVector.push_back(AllSystems::getSystemRucklige());
+    systemsVector.push_back(AllSystems::getSystemSakaraya());
+    systemsVector.push_back(AllSystems::getSystemShimizuMorioka());
+    systemsVector.push_back(AllSystems::getSystemThomas());
+    systemsVector.push_back(AllSystems::getSystemTSUCS1());
+    systemsVector.push_back(AllSystems::getSystemTSUCS2());
+    systemsVector.push_back(AllSystems::getSystemWangSun());
+    systemsVector.push_back(AllSystems::getSystemWimolBanlue());
+    systemsVector.push_back(AllSystems::getSystemYuWang());
     return systemsVector;
 }
 
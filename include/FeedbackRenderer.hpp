@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <QGLShaderProgram>
+#include <QMatrix4x4>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
+
+namespace FeedbackRenderer {
+
+/* Keeps the trails drawn so far in one of two offscreen targets, so that a frame only has to
+   add the newest segments. Every frame carries the previous target over to the other one,
+   faded, and reprojected when the camera has moved. */
+class FeedbackRenderer final {
+public:
+    FeedbackRenderer() = default;
+    ~FeedbackRenderer() = default;
+
+    FeedbackRenderer(const FeedbackRenderer &)            = delete;
+    FeedbackRenderer(FeedbackRenderer &&)                 = delete;
+    FeedbackRenderer &operator=(const FeedbackRenderer &) = delete;
+    FeedbackRenderer &operator=(FeedbackRenderer &&)      = delete;
+
+    void initialize();
+
+    /* Drops the trails, so that the next frame starts from an empty target. */
+    void reset();
+
+    /* Redirects drawing to the target of this frame, of the size of the current viewport and
+       with depth testing on. Returns whether the trails of the previous frame were carried over,
+       otherwise the caller has to draw whole tails. */
+    bool startFrame(const QMatrix4x4 &matrix, float fade);
+
+    /* Copies the target to the framebuffer that was bound before startFrame and restores the
+       state it changed. */
+    void finishFrame();
+
+private:
+    struct Target {
+        GLuint framebuffer = 0;
+        GLuint colorTexture = 0;
+        GLuint depthTexture = 0;
+    };
+
+    void resize(GLsizei newWidth, GLsizei newHeight);
+
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+
+    std::unique_ptr<QGLShaderProgram> fadeProgram;
+    std::unique_ptr<QGLShaderProgram> reprojectProgram;
+    /* Has no attributes, since both passes generate their vertices from gl_VertexID. */
+    QOpenGLVertexArrayObject emptyVertexArray;
+
+    std::array<Target, 2> targets;
+    size_t currentTarget = 0;
+    GLsizei width = 0;
+    GLsizei height = 0;
+
+    bool valid = false;
+    QMatrix4x4 previousMatrix;
+
+    GLint previousFramebuffer = 0;
+    GLint previousReadFramebuffer = 0;
+    GLint previousViewport[4] = {};
+    GLfloat previousClearColor[4] = {};
+    GLboolean depthTestEnabled = GL_FALSE;
+};
+
+} //namespace FeedbackRenderer
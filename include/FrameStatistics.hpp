@@ -0,0 +1,66 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <ostream>
+
+namespace FrameStatistics {
+
+/* The timed parts of a frame. Frame spans the whole frame, the others may overlap it. */
+enum class Section {
+    Camera,
+    Slider,
+    Clear,
+    Draw,
+    Readback,
+    Frame,
+    Count
+};
+
+constexpr size_t SECTIONS_NUMBER = static_cast<size_t>(Section::Count);
+
+const char *getSectionName(Section section);
+
+/* Milliseconds spent in every section, negative for sections that did not run in the frame. */
+struct FrameTimes final {
+    double time = 0; /* milliseconds since the start of the session */
+    std::array<double, SECTIONS_NUMBER> cpu;
+    std::array<double, SECTIONS_NUMBER> gpu;
+
+    FrameTimes();
+};
+
+/* Keeps the times of the latest frames of a session, dropping the oldest beyond the capacity. */
+class FrameStatistics final {
+public:
+    explicit FrameStatistics(size_t capacity);
+    ~FrameStatistics() = default;
+
+    FrameStatistics(const FrameStatistics &)            = delete;
+    FrameStatistics(FrameStatistics &&)                 = delete;
+    FrameStatistics &operator=(const FrameStatistics &) = delete;
+    FrameStatistics &operator=(FrameStatistics &&)      = delete;
+
+    void add(const FrameTimes &times);
+    void clear();
+
+    size_t size() const;
+    const FrameTimes &operator[](size_t index) const;
+
+    /* The mean over the last framesNumber frames of each section, counting only the frames in
+       which it ran. Negative for sections that ran in none of them. */
+    FrameTimes getMean(size_t framesNumber) const;
+
+    /* One row per frame, with empty cells for the sections that did not run. */
+    void writeCsv(std::ostream &stream) const;
+    /* An array of frames, each with cpu and gpu objects keyed by section, without the sections
+       that did not run. */
+    void writeJson(std::ostream &stream) const;
+
+private:
+    size_t capacity;
+    std::deque<FrameTimes> frames;
+};
+
+} //namespace FrameStatistics
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <QOpenGLFunctions_3_3_Core>
+
+#include "FrameStatistics.hpp"
+
+namespace FrameTimer {
+
+/* Times the sections of the frames drawn by the current context, on the CPU with a steady clock
+   and on the GPU with timestamp queries. The GPU results of a frame arrive a few frames later,
+   so they are collected without stalling while later frames are being drawn. */
+class FrameTimer final {
+public:
+    FrameTimer() = default;
+    ~FrameTimer() = default;
+
+    FrameTimer(const FrameTimer &)            = delete;
+    FrameTimer(FrameTimer &&)                 = delete;
+    FrameTimer &operator=(const FrameTimer &) = delete;
+    FrameTimer &operator=(FrameTimer &&)      = delete;
+
+    void initialize();
+
+    /* time is in milliseconds since the start of the session. */
+    void startFrame(double time);
+    /* Forgets the started frame, when nothing has been drawn in it after all. */
+    void cancelFrame();
+    /* Ends the frame and adds every frame whose GPU times are known to statistics. Returns how
+       many frames were added. */
+    size_t finishFrame(FrameStatistics::FrameStatistics &statistics);
+
+    /* Sections are timed at most once per frame and do nothing outside of a frame, such as
+       while a video is being written. */
+    void begin(FrameStatistics::Section section);
+    void end(FrameStatistics::Section section);
+
+    /* For sections that run on other threads. Negative milliseconds are ignored. */
+    void setCpuTime(FrameStatistics::Section section, double milliseconds);
+
+private:
+    /* How many frames may wait for their GPU times before collecting the oldest one stalls. */
+    constexpr static size_t FRAMES_IN_FLIGHT = 4;
+
+    using Clock = std::chrono::steady_clock;
+
+    struct PendingFrame final {
+        FrameStatistics::FrameTimes times;
+        /* A pair of timestamps per section, the first at its beginning. */
+        std::array<GLuint, 2 * FrameStatistics::SECTIONS_NUMBER> queries = {};
+        std::array<bool, FrameStatistics::SECTIONS_NUMBER> queried = {};
+    };
+
+    /* Only the sections that issue GL commands get GPU times. */
+    static bool hasGpuTime(FrameStatistics::Section section);
+
+    /* Waits for the results unless the frame is already available. Returns false if it is not
+       and wait is false. */
+    bool collect(PendingFrame &frame, bool wait);
+
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+
+    std::array<PendingFrame, FRAMES_IN_FLIGHT> frames;
+    std::array<Clock::time_point, FrameStatistics::SECTIONS_NUMBER> starts;
+
+    /* Frames [oldestFrame, oldestFrame + pendingNumber) modulo FRAMES_IN_FLIGHT wait for results. */
+    size_t oldestFrame = 0;
+    size_t pendingNumber = 0;
+    bool frameStarted = false;
+};
+
+} //namespace FrameTimer
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <QMatrix4x4>
+#include <QVector3D>
+#include <QVector4D>
+
+namespace Frustum {
+
+struct BoundingBox final {
+    QVector3D minimum;
+    QVector3D maximum;
+    bool empty = true;
+
+    void extend(const QVector3D &point);
+};
+
+/* The six clipping planes of a projection matrix, extracted with the Gribb-Hartmann method. */
+class Frustum final {
+public:
+    explicit Frustum(const QMatrix4x4 &matrix);
+    ~Frustum() = default;
+
+    /* Conservative: may accept a box that lies just outside a corner of the frustum. */
+    bool intersects(const BoundingBox &box) const;
+
+private:
+    std::array<QVector4D, 6> planes;
+};
+
+} //namespace Frustum
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QVariant>
+#include <QVector>
+
+#include "Locus.hpp"
+#include "Preferences.hpp"
+#include "TiledRenderer.hpp"
+#include "TrajectoryBuffer.hpp"
+#include "VideoEncoder.hpp"
+
+namespace HeadlessRenderer {
+
+/* An OpenGL 3.3 core context of the surfaceless EGL platform, which needs neither a display
+   server nor a GPU when Mesa falls back to software. The handles are kept opaque so that EGL
+   headers stay out of this one. */
+class EglContext final {
+public:
+    EglContext() = default;
+    ~EglContext();
+
+    EglContext(const EglContext &)            = delete;
+    EglContext(EglContext &&)                 = delete;
+    EglContext &operator=(const EglContext &) = delete;
+    EglContext &operator=(EglContext &&)      = delete;
+
+    /* Throws std::runtime_error if EGL has no such context to give. */
+    void create();
+
+    /* A QEGLNativeContext for QOpenGLContext::setNativeHandle. */
+    QVariant getNativeHandle() const;
+
+private:
+    void *display = nullptr;
+    void *context = nullptr;
+};
+
+/* Draws loci without a window, into framebuffers of an OpenGL context on an offscreen surface.
+   The context is made by EglContext and adopted by Qt, and the surface is an EGL pbuffer of the
+   eglfs platform plugin, which has to run on the same surfaceless display. */
+class HeadlessRenderer final {
+public:
+    HeadlessRenderer() = default;
+    ~HeadlessRenderer();
+
+    HeadlessRenderer(const HeadlessRenderer &)            = delete;
+    HeadlessRenderer(HeadlessRenderer &&)                 = delete;
+    HeadlessRenderer &operator=(const HeadlessRenderer &) = delete;
+    HeadlessRenderer &operator=(HeadlessRenderer &&)      = delete;
+
+    /* Must be called on the thread of the application. Throws std::runtime_error if there is no
+       OpenGL 3.3 context to be had. */
+    void initialize();
+
+    void setPreferences(const Preferences::Preferences *prefs);
+
+    void addChunk(const TrajectoryBuffer::TrajectoryChunk &chunk);
+
+    /* Draws in tiles, so the still may be larger than the framebuffer limits. Throws
+       std::runtime_error if the file cannot be written. */
+    void saveStill(const VideoEncoder::FrameState &state, int width, int height, const std::string &filename);
+
+    /* Draws a frame per state. progress gets the percentage of written frames. Throws what
+       VideoEncoder::startEncoding throws. */
+    void saveVideo(const QVector<VideoEncoder::FrameState> &states, int width, int height,
+                   const std::string &filename, std::function<void (int)> progress);
+
+private:
+    /* Declared first, so that Qt lets go of the context before it is destroyed. */
+    EglContext eglContext;
+
+    QOffscreenSurface surface;
+    QOpenGLContext context;
+
+    Locus::LocusController locusController;
+    TiledRenderer::TiledRenderer tiledRenderer;
+    VideoEncoder::VideoEncoder videoEncoder;
+};
+
+} //namespace HeadlessRenderer
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace JobSystem {
+
+enum class Priority {
+    Low,
+    Normal,
+    High
+};
+
+namespace Impl {
+
+struct JobState {
+    std::atomic<bool> cancelled{false};
+    std::atomic<float> progress{0};
+
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    bool finished = false;
+    std::exception_ptr error;
+};
+
+} //namespace Impl
+
+/* Handed to a running job: the job is expected to poll isCancelled() from its main loop. */
+class CancellationToken final {
+public:
+    explicit CancellationToken(std::shared_ptr<Impl::JobState> state);
+
+    bool isCancelled() const;
+
+    void setProgress(float progress) const;
+
+private:
+    std::shared_ptr<Impl::JobState> state;
+};
+
+class JobHandle final {
+public:
+    JobHandle() = default;
+    explicit JobHandle(std::shared_ptr<Impl::JobState> state);
+
+    bool isValid() const;
+
+    void cancel();
+    bool isCancelled() const;
+
+    bool isFinished() const;
+    void wait() const;
+
+    float progress() const;
+
+    /* The exception the job has thrown, if any. */
+    std::exception_ptr error() const;
+
+private:
+    std::shared_ptr<Impl::JobState> state;
+};
+
+class WorkerPool final {
+public:
+    using Job = std::function<void(const CancellationToken &token)>;
+
+    explicit WorkerPool(size_t threadsNumber = std::max(2u, std::thread::hardware_concurrency()));
+    ~WorkerPool();
+
+    WorkerPool(const WorkerPool &)            = delete;
+    WorkerPool(WorkerPool &&)                 = delete;
+    WorkerPool &operator=(const WorkerPool &) = delete;
+    WorkerPool &operator=(WorkerPool &&)      = delete;
+
+    JobHandle submit(Job job, Priority priority = Priority::Normal);
+
+private:
+    struct QueuedJob {
+        Job job;
+        std::shared_ptr<Impl::JobState> state;
+    };
+
+    void workerLoop();
+
+    std::mutex mutex;
+    std::condition_variable jobsCondition;
+    std::array<std::deque<QueuedJob>, 3> jobs;
+    bool stopping;
+
+    std::vector<std::thread> workers;
+};
+
+} //namespace JobSystem
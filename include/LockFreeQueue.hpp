@@ -0,0 +1,110 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace LockFreeQueue {
+
+/* Bounded multi-producer multi-consumer queue: every cell carries a sequence number
+   telling whether it is ready to be written or read at the given position. */
+template<typename T>
+class LockFreeQueue final {
+public:
+    explicit LockFreeQueue(size_t capacity);
+    ~LockFreeQueue() = default;
+
+    LockFreeQueue(const LockFreeQueue &)            = delete;
+    LockFreeQueue(LockFreeQueue &&)                 = delete;
+    LockFreeQueue &operator=(const LockFreeQueue &) = delete;
+    LockFreeQueue &operator=(LockFreeQueue &&)      = delete;
+
+    /* Leaves value untouched and returns false when the queue is full. */
+    bool tryPush(T &&value);
+
+    bool tryPop(T &value);
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    constexpr static size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> pushPosition;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> popPosition;
+};
+
+template<typename T>
+LockFreeQueue<T>::LockFreeQueue(size_t capacity) :
+    pushPosition{0},
+    popPosition{0} {
+
+    size_t roundedCapacity = 2;
+    while (roundedCapacity < capacity) {
+        roundedCapacity *= 2;
+    }
+    cells.reset(new Cell[roundedCapacity]);
+    mask = roundedCapacity - 1;
+
+    for (size_t i = 0; i < roundedCapacity; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+template<typename T>
+bool LockFreeQueue<T>::tryPush(T &&value) {
+    Cell *cell;
+    size_t position = pushPosition.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+        if (difference == 0) {
+            if (pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->data = std::move(value);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+template<typename T>
+bool LockFreeQueue<T>::tryPop(T &value) {
+    Cell *cell;
+    size_t position = popPosition.load(std::memory_order_relaxed);
+    while (true) {
+        cell = &cells[position & mask];
+        size_t sequence = cell->sequence.load(std::memory_order_acquire);
+        auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position + 1);
+        if (difference == 0) {
+            if (popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            return false;
+        } else {
+            position = popPosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    value = std::move(cell->data);
+    cell->data = T{};
+    cell->sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+}
+
+} //namespace LockFreeQueue
@@ -1,29 +1,56 @@
 #pragma once
 
+#include <deque>
+#include <vector>
 #include <QOpenGLBuffer>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
 #include <QVector3D>
 #include <QVector>
 #include <QColor>
 
+#include "DensityRenderer.hpp"
+#include "FeedbackRenderer.hpp"
+#include "FrameTimer.hpp"
+#include "Frustum.hpp"
+#include "LocusLayout.hpp"
+#include "LocusProgress.hpp"
 #include "Preferences.hpp"
 #include "ShaderController.hpp"
+#include "TrajectoryBuffer.hpp"
 
 namespace Locus {
 
-class Locus final {
+/* Bookkeeping of one trajectory, whose points live in the region of the shared vertex buffer
+   that starts at its index times the region size. */
+class Locus final : public LocusProgress::LocusProgress {
 public:
-    Locus(QVector<QVector3D> &&points_);
+    /* Points are grouped into blocks of this size. Each block has its own bounding box, which
+       serves both for culling and as the range of its 16-bit quantised coordinates. */
+    constexpr static size_t BLOCK_SIZE = 1024;
+
     Locus() = default;
     ~Locus() = default;
 
-    size_t size() const;
+    /* Drops the boxes of the blocks before firstBlock, which live mode no longer keeps. */
+    void forgetBlocksBefore(size_t firstBlock);
+
+    const Frustum::BoundingBox &getBounds() const;
+    const Frustum::BoundingBox &getBlockBounds(size_t block) const;
+
+    /* The mean distance between consecutive points. */
+    float getStepLength() const;
+    QVector3D getCenter() const;
+    float getRadius() const;
 
-    void startWork();
-    void endWork();
+    void append(const float *points, size_t count, bool last);
 
 private:
-    QOpenGLBuffer pointsBuffer;
-    QVector<size_t> startIndexes;
+    Frustum::BoundingBox bounds;
+    std::deque<Frustum::BoundingBox> blockBounds;
+    size_t firstBlock = 0;
+    QVector3D lastPoint;
+    double pathLength = 0;
 };
 
 class LocusController final {
@@ -40,19 +67,124 @@ public:
 
     size_t size() const;
 
-    void addLocus(QVector<QVector3D> &&points_);
+    void addChunk(const TrajectoryBuffer::TrajectoryChunk &chunk);
+
+    /* The number of points already uploaded for every locus that is still being computed. */
+    size_t computedPointsNumber() const;
 
     void clear();
 
     void draw(const QMatrix4x4 &projMatrix, size_t time);
 
+    /* Whether the picture may differ from the last drawn one for reasons other than the matrix
+       and the time, which the caller compares itself. Resets the flag. */
+    bool takeChanged();
+
     void setPreferences(const Preferences::Preferences *prefs);
 
+    /* Times clearing the screen, if set. */
+    void setFrameTimer(FrameTimer::FrameTimer *timer);
+
+    /* Live mode keeps only the newest points of every locus in a ring of fixed size, enough for
+       tails of tailPointsNumber while the computation runs up to leadPointsNumber points ahead of
+       the drawn time. Zeros switch back to whole trajectories. */
+    void setRingSize(size_t tailPointsNumber, size_t leadPointsNumber);
+
 private:
+    /* How many points before the previously drawn time feedback trails draw again. */
+    constexpr static size_t FEEDBACK_OVERLAP = 3;
+
+    size_t getLevelsNumber() const;
+
+    /* Clamps tails in live mode to the points the ring still holds. */
+    size_t getMaxTailPointsNumber(size_t tailPointsNumber) const;
+
+    void clearScreen();
+
+    /* The coarsest level whose gaps stay below the allowed error once projected with projMatrix. */
+    size_t selectLevel(const Locus &locus, const QMatrix4x4 &projMatrix, float viewportHeight) const;
+
+    /* Returns false if the buffer for the new layout could not be had. */
+    bool reallocate(size_t locusNumber, size_t newCapacity);
+
+    /* Drops a chunk that does not fit into the vertex buffer. */
+    void refuseChunk(const TrajectoryBuffer::TrajectoryChunk &chunk);
+
+    size_t getBlocksPerRegion() const;
+
+    /* The uploaded points of the locus after sizesBase. */
+    GLint getRelativeSize(const Locus &locus) const;
+    void uploadLocusSizes();
+    void uploadBlockBounds(size_t locusIndex, size_t block);
+
+    /* Quantises the pending points of a block against its box and writes them to every level. */
+    void uploadBlock(size_t locusIndex, size_t count);
+
+    /* Draws the tails of all loci as points growing towards their heads in one instanced draw. */
+    void drawHeads(const QMatrix4x4 &projMatrix, size_t time);
+
+    /* Draws the last tailPointsNumber points before time into the bound framebuffer, as density
+       splats in densityMode. */
+    void drawTrajectories(const QMatrix4x4 &projMatrix, size_t time, size_t tailPointsNumber,
+                          bool densityMode, bool tailColoringMode);
+
+    /* Adds the draw range of level points [first, last) of the region at regionOffset. */
+    void addDrawRange(size_t regionOffset, size_t first, size_t last, bool vertexSmoothing, GLint splineSegments);
+
     QVector<Locus> data;
+    size_t capacity = 0;
+    size_t regionSize = 0;
+
+    /* In live mode every point is written both at its index modulo ringSize and ringSize
+       slots later, so any window of at most ringSize points is contiguous in the region. */
+    size_t ringSize = 0;
+    size_t ringLead = 0;
+    std::vector<GLushort> packedPoints;
     ShaderController::ShaderController shaderController;
+    DensityRenderer::DensityRenderer densityRenderer;
+    FeedbackRenderer::FeedbackRenderer feedbackRenderer;
+    size_t feedbackTime = 0;
+
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+
+    QOpenGLBuffer pointsBuffer;
+    QOpenGLVertexArrayObject vertexArray;
+    /* Has no attributes, since spline and head vertices are generated from gl_VertexID alone. */
+    QOpenGLVertexArrayObject splineVertexArray;
+
+    /* Per-locus (first drawn vertex, drawn length, level shift, level offset), read by the vertex
+       shader as a texture buffer. */
+    GLuint locusDataBuffer = 0;
+    GLuint locusDataTexture = 0;
+
+    /* The points as a texture buffer, from which the vertex shader reads spline control points. */
+    GLuint pointsTexture = 0;
+    GLint maxTextureBufferSize = 0;
+
+    /* The number of uploaded points of every locus after sizesBase, a multiple of ringSize that
+       heads move forward as the time runs, so the values fit into GLSL ints. */
+    GLuint locusSizesBuffer = 0;
+    GLuint locusSizesTexture = 0;
+    size_t sizesBase = 0;
+
+    /* Two texels per block: the minimum corner of its box and its extent. */
+    GLuint blockBoundsBuffer = 0;
+    GLuint blockBoundsTexture = 0;
+
+    std::vector<GLint> locusData;
+    bool locusDataChanged = true;
+    std::vector<GLint> drawFirsts;
+    std::vector<GLsizei> drawCounts;
+
+    /* Reported once per run. */
+    bool allocationFailed = false;
+
+    /* Set when points were uploaded before the drawn time, or the layout changed. */
+    bool changed = true;
+    size_t drawnTime = 0;
 
     const Preferences::Preferences *prefs;
+    FrameTimer::FrameTimer *frameTimer = nullptr;
 };
 
 } //namespace Locus
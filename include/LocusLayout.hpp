@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LocusLayout {
+
+/* A region holds every level of detail of its locus one after another. Level L keeps
+   each (1 << LOD_LEVEL_SHIFT)-th point of level L - 1, so all levels together take a
+   third more memory than the full trajectory. */
+constexpr size_t LOD_LEVELS = 4;
+constexpr size_t LOD_LEVEL_SHIFT = 2;
+
+size_t getLevelSize(size_t pointsNumber, size_t level);
+
+/* Where level starts in a region of loci of at most pointsCapacity points, and with level equal
+   to the number of levels, the size of the region. */
+size_t getLevelOffset(size_t pointsCapacity, size_t level);
+
+/* How many of locusNumber regions of regionSize points fit together within maxPointsNumber.
+   Regions of empty loci take no room, so any number of them fits. */
+size_t getMaxLocusNumber(size_t regionSize, size_t locusNumber, size_t maxPointsNumber);
+
+} //namespace LocusLayout
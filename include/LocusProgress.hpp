@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace LocusProgress {
+
+/* How far the points of one trajectory got on their way to the vertex buffer. */
+class LocusProgress {
+public:
+    LocusProgress() = default;
+    ~LocusProgress() = default;
+
+    /* The number of uploaded points. */
+    size_t size() const;
+
+    /* The number of appended points, uploaded or not. */
+    size_t getAppendedNumber() const;
+
+    /* Whether the last points came and all of them were uploaded. */
+    bool isComplete() const;
+
+    /* Points wait here until their block is full, or the trajectory is, because quantisation
+       needs the final box of the block. They continue the uploaded points. */
+    const float *getPendingPoints() const;
+    size_t getPendingNumber() const;
+    void markUploaded(size_t count);
+
+    void append(const float *points, size_t count, bool last);
+
+    /* Ends the trajectory at the uploaded points and drops the pending ones. */
+    void finish();
+
+private:
+    size_t pointsNumber = 0;
+    size_t uploadedNumber = 0;
+    bool complete = false;
+
+    std::vector<float> pendingPoints;
+    size_t pendingStart = 0;
+};
+
+} //namespace LocusProgress
@@ -11,27 +11,38 @@ namespace Impl {
 
 constexpr long double COORDINATE_VALUE_LIMIT = 1e3;
 
+inline bool isInsideLimits(const Point &point) {
+    return std::abs(point.x) < COORDINATE_VALUE_LIMIT &&
+           std::abs(point.y) < COORDINATE_VALUE_LIMIT &&
+           std::abs(point.z) < COORDINATE_VALUE_LIMIT;
+}
+
 template<typename LambdaNextPointGenerator, typename LambdaNewPointAction>
 void generatePointsMainloop(LambdaNewPointAction &&newPointAction,
                             Point point,
                             int pointsCount,
                             LambdaNextPointGenerator &&nextPoint) {
-    for (int i = 0; i < pointsCount &&
-                    std::abs(point.x) < COORDINATE_VALUE_LIMIT &&
-                    std::abs(point.y) < COORDINATE_VALUE_LIMIT &&
-                    std::abs(point.z) < COORDINATE_VALUE_LIMIT; ++i) {
+    for (int i = 0; i < pointsCount && isInsideLimits(point); ++i) {
         newPointAction(point = nextPoint(point));
     }
 }
 
+template<typename LambdaNextPointGenerator>
+int generatePointsBlockMainloop(Point *points,
+                                Point &point,
+                                int pointsCount,
+                                LambdaNextPointGenerator &&nextPoint) {
+    int i = 0;
+    for (; i < pointsCount && isInsideLimits(point); ++i) {
+        points[i] = point = nextPoint(point);
+    }
+    return i;
+}
+
 
-template<typename LambdaDerivatives, typename LambdaNewPointAction>
-void setNextPointGenerator(LambdaNewPointAction &&newPointAction,
-                           Point point,
-                           int pointsCount,
-                           long double tau,
-                           LambdaDerivatives &&countDerivatives) {
-    auto nextPoint = [tau, countDerivatives = std::forward<LambdaDerivatives>(countDerivatives)]
+template<typename LambdaDerivatives>
+auto getNextPointGenerator(long double tau, LambdaDerivatives &&countDerivatives) {
+    return [tau, countDerivatives = std::forward<LambdaDerivatives>(countDerivatives)]
             (const Point &point) {
         Point k1 = countDerivatives(point);
         Point send{
@@ -54,10 +65,6 @@ void setNextPointGenerator(LambdaNewPointAction &&newPointAction,
                 point.z + (tau / 6) * (k1.z + k4.z + 2 * (k2.z + k3.z))
         };
     };
-    generatePointsMainloop(std::forward<LambdaNewPointAction>(newPointAction),
-                           point,
-                           pointsCount,
-                           std::move(nextPoint));
 }
 
 } // namespace Impl
@@ -68,11 +75,22 @@ void generatePoints(LambdaNewPointAction &&newPointAction,
                     int pointsCount,
                     long double tau,
                     LambdaDerivatives &&countDerivatives) {
-    Impl::setNextPointGenerator(std::forward<LambdaNewPointAction>(newPointAction),
-                                point,
-                                pointsCount,
-                                tau,
-                                std::forward<LambdaDerivatives>(countDerivatives));
+    Impl::generatePointsMainloop(std::forward<LambdaNewPointAction>(newPointAction),
+                                 point,
+                                 pointsCount,
+                                 Impl::getNextPointGenerator(tau, std::forward<LambdaDerivatives>(countDerivatives)));
+}
+
+template<typename LambdaDerivatives>
+int generatePointsBlock(Point *points,
+                        Point &point,
+                        int pointsCount,
+                        long double tau,
+                        LambdaDerivatives &&countDerivatives) {
+    return Impl::generatePointsBlockMainloop(points,
+                                             point,
+                                             pointsCount,
+                                             Impl::getNextPointGenerator(tau, std::forward<LambdaDerivatives>(countDerivatives)));
 }
 
 }//namespace Model
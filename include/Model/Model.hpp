@@ -6,6 +6,10 @@ struct Point {
     long double x, y, z;
 };
 
+enum class Integrator {
+    RungeKutta4
+};
+
 template<typename LambdaDerivatives, typename LambdaNewPointAction>
 void generatePoints(LambdaNewPointAction &&newPointAction,
                     Point point,
@@ -13,6 +17,15 @@ void generatePoints(LambdaNewPointAction &&newPointAction,
                     long double tau,
                     LambdaDerivatives &&countDerivatives);
 
+/* Writes up to pointsCount points into points and leaves point at the last generated one,
+   so consecutive calls continue the same trajectory. Returns the number of points written. */
+template<typename LambdaDerivatives>
+int generatePointsBlock(Point *points,
+                        Point &point,
+                        int pointsCount,
+                        long double tau,
+                        LambdaDerivatives &&countDerivatives);
+
 } // namespace Model
 
-#include "Model/Impl/ModelImpl.hpp"
\ No newline at end of file
+#include "Model/Impl/ModelImpl.hpp"
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <png.h>
+
+namespace PngStreamWriter {
+
+/* Writes an 8-bit RGB PNG row by row from the top, compressing every row as it comes, so that
+   images larger than the memory can be written. */
+class PngStreamWriter final {
+public:
+    PngStreamWriter() = default;
+    ~PngStreamWriter();
+
+    PngStreamWriter(const PngStreamWriter &)            = delete;
+    PngStreamWriter(PngStreamWriter &&)                 = delete;
+    PngStreamWriter &operator=(const PngStreamWriter &) = delete;
+    PngStreamWriter &operator=(PngStreamWriter &&)      = delete;
+
+    /* Throws std::runtime_error if the file cannot be created. */
+    void open(const std::string &filename, uint32_t imageWidth, uint32_t imageHeight);
+
+    /* Takes 3 * width bytes. Throws std::runtime_error if writing fails. */
+    void writeRow(const uint8_t *row);
+
+    /* Finishes the file once all the rows are written and throws std::logic_error otherwise. */
+    void close();
+
+    bool isOpen() const;
+
+private:
+    /* libpng reports errors by jumping back to the caller, which must not have locals with
+       destructors, so the functions that call it only return whether it succeeded. */
+    bool writeHeader();
+    bool writePngRow(const uint8_t *row);
+    bool writeEnd();
+
+    void destroy();
+
+    FILE *file = nullptr;
+    png_structp png = nullptr;
+    png_infop info = nullptr;
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t writtenRows = 0;
+};
+
+} //namespace PngStreamWriter
@@ -1,36 +1,55 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <QGLWidget>
 #include <QMouseEvent>
 #include <QWheelEvent>
 #include <QKeyEvent>
-#include <QTime>
-#include <QTimer>
 
 #include "Camera.hpp"
+#include "FrameStatistics.hpp"
+#include "FrameTimer.hpp"
 #include "Locus.hpp"
 #include "Preferences.hpp"
+#include "QualityGovernor.hpp"
+#include "RenderThread.hpp"
+#include "StatisticsOverlay.hpp"
+#include "TiledRenderer.hpp"
 #include "VideoEncoder.hpp"
 #include "Window.hpp"
 
+/* Renders on its own thread, which owns the GL context once the widget is shown. The public
+   methods are called from the GUI thread and hand everything touching GL to the render thread. */
 class PointsViewQGLWidget : public QGLWidget {
 public:
     explicit PointsViewQGLWidget(QWidget *parent = nullptr);
-    ~PointsViewQGLWidget() = default;
+    ~PointsViewQGLWidget();
 
     void clearAll();
 
     void keyPressEvent(QKeyEvent *event) override;
     void keyReleaseEvent(QKeyEvent *event) override;
 
-    void setCurrentTime(const int currentTime_);
+    void setCurrentTime(const size_t currentTime_);
 
-    void addNewLocus(QVector<QVector3D> &&points);
+    /* The CPU time of the last slider update, reported with the next drawn frame. */
+    void setSliderTime(double milliseconds);
 
+    /* See LocusController::setRingSize. */
+    void setRingSize(size_t tailPointsNumber, size_t leadPointsNumber);
+
+    void addChunk(const TrajectoryBuffer::TrajectoryChunk &chunk);
+
+    /* As of the last frame, since the chunks are uploaded by the render thread. */
+    size_t computedPointsNumber() const;
+
+    /* The render thread works with a copy, so this has to be called again after prefs change. */
     void setPreferences(const Preferences::Preferences *prefs);
 
     bool startVideoRecording(const QString &filename);
 
+    /* May call back from the render thread. */
     void endVideoRecording(std::function<void(int)> callback);
 
 protected:
@@ -38,6 +57,10 @@ protected:
     void resizeGL(int width, int height) override;
     void paintGL() override;
 
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+
     void mouseMoveEvent(QMouseEvent *event) override;
     void mousePressEvent(QMouseEvent *event) override;
 
@@ -48,13 +71,71 @@ protected:
 private:
     Q_OBJECT
 
+    static QGLFormat getFormat();
+
+    /* Runs on the render thread. Draws only when the picture can differ from the last one. */
+    bool renderFrame();
+    void saveScreenshot();
+    void saveStatistics();
+    /* Renders the current view in tiles at the poster size of the preferences. */
+    void savePoster();
+
+    /* Feeds the frames just added to the statistics to the governor. */
+    void governQuality(size_t framesNumber);
+    /* Copies the preferences with the governor's levels applied for the locus controller. */
+    void updateGovernedPreferences();
+
+    /* Draws the overlay if it is enabled, repainting its text a few times per second. */
+    void drawStatisticsOverlay();
+
+    /* Asks the render thread for a frame even if nothing it tracks has changed. */
+    void requestRedraw();
+
     const Preferences::Preferences *prefs;
 
+    /* Everything below is only touched by the render thread, except for the atomics. */
+    Preferences::Preferences renderPreferences;
+    Preferences::Preferences governedPreferences;
+
     Locus::LocusController locusController;
 
     Camera::KeyboardAndMouseController cameraController;
 
     VideoEncoder::VideoEncoder videoEncoder;
 
-    size_t currentTime;
+    std::atomic<size_t> currentTime;
+    std::atomic<size_t> computedPoints;
+
+    /* The frontier of the render thread belongs to the previous run until the clear posted by
+       clearAll has been done, so it only counts once these agree. */
+    std::atomic<size_t> requestedClears;
+    std::atomic<size_t> finishedClears;
+
+    std::atomic<int> viewportWidth;
+    std::atomic<int> viewportHeight;
+    int renderedWidth = 0;
+    int renderedHeight = 0;
+
+    std::atomic<bool> screenshotRequested;
+    std::atomic<bool> redrawRequested;
+    std::chrono::steady_clock::time_point lastFrameTime;
+
+    /* About twenty minutes of frames at 60 frames per second. */
+    constexpr static size_t SESSION_FRAMES = 1 << 16;
+    constexpr static size_t OVERLAY_MEAN_FRAMES = 30;
+    constexpr static int OVERLAY_UPDATE_MILLISECONDS = 250;
+
+    FrameTimer::FrameTimer frameTimer;
+    FrameStatistics::FrameStatistics frameStatistics;
+    StatisticsOverlay::StatisticsOverlay statisticsOverlay;
+    QualityGovernor::QualityGovernor qualityGovernor;
+    TiledRenderer::TiledRenderer tiledRenderer;
+    std::atomic<double> sliderMilliseconds;
+    std::chrono::steady_clock::time_point sessionStart;
+    std::chrono::steady_clock::time_point overlayUpdateTime;
+
+    QMatrix4x4 renderedMatrix;
+    size_t renderedTime = 0;
+
+    RenderThread::RenderThread renderThread;
 };
@@ -19,9 +19,22 @@ private:
         size_t locusNumber = 200;
 
         float interpolationDistance = 0.15;
+        bool vertexSmoothing = true; /* expand splines in the vertex shader instead of the geometry shader */
+        int splineSegments = 8;
+        float lodPixelError = 1.0; /* the largest gap in pixels that a decimated level may leave on screen */
         float startPointSize = 0;
         float finalPointSize = 10;
 
+        bool densityMode = false; /* splat points additively and tone map their density */
+        float densityExposure = 0.5;
+
+        bool instancedHeads = false; /* draw short tails of huge ensembles as points in one instanced draw */
+        bool feedbackTrails = false; /* keep drawn trails in a texture and add only the newest segments */
+        float trailFade = 0.95; /* the brightness a trail keeps from one frame to the next */
+
+        bool statisticsOverlay = false; /* show CPU and GPU frame times over the picture */
+        bool adaptiveQuality = false; /* lower the detail while frames take longer than the target frame rate allows */
+
         GLenum primitive = GL_LINE_STRIP;
 
         bool arcadeMode = false;
@@ -33,11 +46,15 @@ private:
     struct VideoPreferences final {
         size_t width = 1920;
         size_t height = 1080;
+
+        int posterWidth = 16384; /* the size of the tiled P-key stills */
+        int posterHeight = 16384;
     };
 
     struct ControllerPreferences final {
-        int sliderTimeInterval = 1;
-        int deltaTimePerStep = 1;
+        int sliderTimeInterval = 16; /* how often the GUI takes computed chunks and moves the slider */
+        int deltaTimePerStep = 1; /* slider steps per millisecond */
+        int targetFrameRate = 60;
 
         bool preferencesChanged = false;
     };
@@ -48,6 +65,10 @@ private:
         double deltaTime = 0.01;
         float divNormalization = 8;
         float startPointDelta = 0.05;
+        int chunkPointsNumber = 4096;
+        int cacheMemoryBudget = 1024; /* in megabytes */
+        int diskCacheBudget = 4096; /* in megabytes, 0 disables the disk cache */
+        bool liveMode = false;
     };
 
 public:
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+namespace QualityGovernor {
+
+/* What the governor may trade for time, in the order it gives them up. */
+enum class Knob {
+    Subdivision,
+    LevelOfDetail,
+    PointBudget,
+    Count
+};
+
+constexpr size_t KNOBS_NUMBER = static_cast<size_t>(Knob::Count);
+
+const char *getKnobName(Knob knob);
+
+/* The drawing settings the governor scales down from the ones the user asked for. */
+struct Settings final {
+    int splineSegments;
+    float interpolationDistance;
+    float lodPixelError;
+    size_t tailPointsNumber;
+};
+
+struct Adjustment final {
+    Knob knob;
+    bool lowered;
+    size_t level;
+};
+
+/* Keeps frames within a target time by lowering the quality knobs one step at a time while
+   frames are too slow, and raising them back in the reverse order while frames are much faster
+   than needed. The band between the two thresholds and the cooldown after every step keep it
+   from oscillating. */
+class QualityGovernor final {
+public:
+    /* Every knob has this many steps below the requested quality. */
+    constexpr static size_t MAX_LEVEL = 3;
+
+    explicit QualityGovernor(double targetMilliseconds);
+    ~QualityGovernor() = default;
+
+    QualityGovernor(const QualityGovernor &)            = delete;
+    QualityGovernor(QualityGovernor &&)                 = delete;
+    QualityGovernor &operator=(const QualityGovernor &) = delete;
+    QualityGovernor &operator=(QualityGovernor &&)      = delete;
+
+    void setTarget(double targetMilliseconds);
+
+    /* Takes the time of a drawn frame and returns the knob it turned, if any. */
+    std::optional<Adjustment> addFrame(double milliseconds);
+
+    /* Goes back to the requested quality and forgets the measured times. */
+    void reset();
+
+    size_t getLevel(Knob knob) const;
+
+    /* The requested settings lowered by the current levels. */
+    Settings apply(const Settings &requested) const;
+
+    /* The knobs that are turned down, such as "subdivision -1, point budget -2", or "full quality". */
+    std::string describe() const;
+
+private:
+    /* The smoothing factor of the frame time average. */
+    constexpr static double SMOOTHING = 0.1;
+    /* Lowering starts above the target, raising only once frames are well below it. */
+    constexpr static double LOWER_RATIO = 1.0;
+    constexpr static double RAISE_RATIO = 0.6;
+    constexpr static size_t LOWER_FRAMES = 15;
+    constexpr static size_t RAISE_FRAMES = 120;
+    /* Frames after a step whose times do not count, since they still show the old settings. */
+    constexpr static size_t COOLDOWN_FRAMES = 30;
+
+    void restart();
+
+    double target;
+    double smoothedTime = 0;
+    size_t measuredFrames = 0;
+    size_t slowFrames = 0;
+    size_t fastFrames = 0;
+    size_t cooldown = 0;
+
+    std::array<size_t, KNOBS_NUMBER> levels = {};
+};
+
+} //namespace QualityGovernor
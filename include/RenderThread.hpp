@@ -0,0 +1,66 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <QThread>
+
+namespace RenderThread {
+
+/* Runs the frame loop of a GL context that has been moved to it. Other threads hand it work
+   as commands, which run with the context current between two frames. When a frame finds
+   nothing to draw, the thread sleeps until a command or a wake up arrives. */
+class RenderThread final : public QThread {
+public:
+    using Command = std::function<void()>;
+    /* Returns whether it has drawn a frame. */
+    using Frame = std::function<bool()>;
+
+    RenderThread() = default;
+    ~RenderThread() override;
+
+    RenderThread(const RenderThread &)            = delete;
+    RenderThread(RenderThread &&)                 = delete;
+    RenderThread &operator=(const RenderThread &) = delete;
+    RenderThread &operator=(RenderThread &&)      = delete;
+
+    /* Run on the thread once before the first frame, every frame, and once after the last one. */
+    void setCallbacks(Command initialize, Frame frame, Command finish);
+
+    /* Caps the frame rate where swapping buffers does not wait for vsync. */
+    void setTargetFrameRate(int framesPerSecond);
+
+    void post(Command command);
+
+    /* Makes a sleeping thread try another frame. */
+    void wake();
+
+    /* Posts the command and waits until it has run, still delivering the events of the calling
+       thread other than user input. The thread has to be running. */
+    void invoke(Command command);
+
+    void stop();
+
+protected:
+    void run() override;
+
+private:
+    void executeCommands();
+
+    Command initializeCallback;
+    Frame frameCallback;
+    Command finishCallback;
+
+    std::mutex commandsMutex;
+    std::condition_variable wakeCondition;
+    std::vector<Command> commands;
+    std::vector<Command> executedCommands;
+    bool wakeRequested = false;
+
+    std::atomic<bool> stopFlag{false};
+    std::atomic<int> targetFrameRate{60};
+};
+
+} //namespace RenderThread
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Model/Model.hpp"
+#include "DynamicSystems/DynamicSystem.hpp"
+
+namespace RunDescription {
+
+/* Everything a computation needs. It is captured on the GUI thread and never modified
+   afterwards, so any worker may read it without synchronisation. */
+struct RunDescription final {
+    std::shared_ptr<const DynamicSystems::DynamicSystem> system;
+    std::vector<long double> constants;
+
+    std::vector<Model::Point> startPoints;
+    int pointsNumber;
+    int chunkPointsNumber;
+
+    long double timeDelta;
+    Model::Integrator integrator;
+
+    float normalizeConstant;
+
+    /* Integrate without end instead of pointsNumber points, keeping nothing but the tails. */
+    bool live;
+};
+
+/* Identifies the trajectory of one locus: equal keys mean bit-identical trajectories. */
+std::string getTrajectoryKey(const RunDescription &description, size_t locusIndex);
+
+} //namespace RunDescription
@@ -1,13 +1,50 @@
 #pragma once
 
+#include <array>
+#include <memory>
 #include <QGLShader>
 #include <QGLShaderProgram>
+#include <QOpenGLFunctions_3_3_Core>
+
+#include "ShaderProgramCache.hpp"
 
 namespace ShaderController {
 
+/* Mirrors the std140 layout of the FrameState uniform block in FrameState.glsl. */
+struct FrameState final {
+    constexpr static int MAX_COLORS_NUMBER = 20;
+
+    GLfloat matrix[16];
+    GLfloat colors[MAX_COLORS_NUMBER][4];
+
+    GLint regionSize;
+    GLint trajectoriesNumber;
+    GLint colorsNumber;
+    GLfloat startTailSize;
+    GLfloat finalTailSize;
+    GLfloat interpolationDist;
+    GLint splineSegments;
+    GLint blockSize;
+    GLint blocksPerRegion;
+    GLint currentTime;
+    GLint tailPointsNumber;
+    GLint ringSize;
+};
+
 class ShaderController final {
 public:
-    ShaderController()  = default;
+    /* Identifies one of the linked programs, built for a primitive and a set of display modes. */
+    using ProgramHandle = size_t;
+
+    enum class Technique {
+        Tails,
+        /* Plain points of the vertex buffer, splatted additively. */
+        Density,
+        /* The tails of all loci as points, in one instanced draw with no vertex buffer. */
+        InstancedHeads
+    };
+
+    ShaderController();
     ~ShaderController() = default;
 
     ShaderController(const ShaderController &)            = delete;
@@ -15,29 +52,78 @@ public:
     ShaderController &operator=(const ShaderController &) = delete;
     ShaderController &operator=(ShaderController &&)      = delete;
 
+    constexpr static GLint LOCUS_DATA_TEXTURE_UNIT = 0;
+    constexpr static GLint POINTS_TEXTURE_UNIT = 1;
+    constexpr static GLint BLOCK_BOUNDS_TEXTURE_UNIT = 2;
+    constexpr static GLint LOCUS_SIZES_TEXTURE_UNIT = 3;
+
+    /* For tails, with vertexSmoothing the program draws plain points or line strips of spline
+       vertices, otherwise it expects line strips with adjacency for the geometry shader. The other
+       techniques draw points and only depend on tailColoringMode. */
+    static ProgramHandle getProgramHandle(Technique technique, GLenum primitive, bool arcadeMode,
+                                          bool tailColoringMode, bool vertexSmoothing);
+
+    /* Links every program getProgramHandle can return. */
     void initialize();
 
+    /* Binds the selected program and uploads the frame state if any setter changed it since the last call. */
     void startWork();
     void endWork();
 
+    void setProgram(ProgramHandle handle);
+
     void setMatrix(const QMatrix4x4 &matrix);
     void setVertex();
-    void setArcadeMode(bool enabled);
     void setStartTailSize(float size);
     void setFinalTailSize(float size);
-    void setTailLength(size_t length);
-    void setStartVertexIndex(size_t index);
-    void setTailColoringMode(bool enabled);
-    void setTrajectoryIndex(size_t index);
+    void setRegionSize(size_t size);
     void setTrajectoriesNumber(size_t number);
     void setColors(const QVector<QVector4D> &colors);
     void setInterpolationDistance(float distance);
-    void setPrimitive(GLenum primitive);
+    void setSplineSegments(int segments);
+    void setBlockLayout(size_t blockSize, size_t blocksPerRegion);
+    void setCurrentTime(size_t time);
+    void setTailPointsNumber(size_t number);
+    void setRingSize(size_t size);
 private:
-    QGLShaderProgram shaderProgram;
+    constexpr static GLuint FRAME_STATE_BINDING = 0;
+    constexpr static int VERTEX_LOCATION = 0;
+
+    constexpr static ProgramHandle POINTS_BIT           = 1 << 0;
+    constexpr static ProgramHandle ARCADE_MODE_BIT      = 1 << 1;
+    constexpr static ProgramHandle TAIL_COLORING_BIT    = 1 << 2;
+    constexpr static ProgramHandle VERTEX_SMOOTHING_BIT = 1 << 3;
+    constexpr static ProgramHandle DENSITY_MODE_BIT     = 1 << 4;
+    constexpr static ProgramHandle INSTANCED_HEADS_BIT  = 1 << 5;
+    constexpr static ProgramHandle PROGRAMS_NUMBER      = 1 << 6;
+
+    static bool isReachable(ProgramHandle handle);
+
+    template <typename T>
+    void updateState(T &field, const T &value);
+
+    QByteArray getShaderSource(const QByteArray &source, ProgramHandle handle) const;
+
+    std::unique_ptr<QGLShaderProgram> createProgram(ProgramHandle handle);
+
+    std::array<std::unique_ptr<QGLShaderProgram>, PROGRAMS_NUMBER> programs;
+    ProgramHandle currentProgram = 0;
+
+    QByteArray vertexSource;
+    QByteArray splineVertexSource;
+    QByteArray headVertexSource;
+    QByteArray geometryPointsSource;
+    QByteArray geometryLinesSource;
+    QByteArray fragmentSource;
+    QByteArray frameStateSource;
+
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+
+    ShaderProgramCache::ShaderProgramCache programCache;
 
-    QGLShader* gshPoints;
-    QGLShader* gshLines;
+    GLuint frameStateBuffer = 0;
+    FrameState frameState{};
+    bool frameStateChanged = true;
 };
 
 } //class ShaderController
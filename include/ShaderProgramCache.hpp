@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QByteArray>
+#include <QOpenGLContext>
+#include <QOpenGLFunctions>
+#include <QString>
+#include <QVector>
+
+namespace ShaderProgramCache {
+
+/* Keeps linked program binaries on disk, keyed by the driver identity and the shader sources,
+   so that later launches skip compiling and linking. Without GL_ARB_get_program_binary
+   it stays disabled and every program is built from source. */
+class ShaderProgramCache final {
+public:
+    explicit ShaderProgramCache(QString directory);
+    ~ShaderProgramCache() = default;
+
+    ShaderProgramCache(const ShaderProgramCache &)            = delete;
+    ShaderProgramCache(ShaderProgramCache &&)                 = delete;
+    ShaderProgramCache &operator=(const ShaderProgramCache &) = delete;
+    ShaderProgramCache &operator=(ShaderProgramCache &&)      = delete;
+
+    void initialize(QOpenGLContext *context);
+
+    QByteArray getKey(const QVector<QByteArray> &sources) const;
+
+    /* Returns whether program was loaded and linked from the binary stored under key. */
+    bool load(GLuint program, const QByteArray &key) const;
+
+    /* Must be called before linking a program that is going to be stored. */
+    void prepare(GLuint program) const;
+    void store(GLuint program, const QByteArray &key) const;
+
+    static QString getDefaultDirectory();
+
+private:
+    using GetProgramBinary = void (QOPENGLF_APIENTRYP)(GLuint, GLsizei, GLsizei *, GLenum *, void *);
+    using ProgramBinary = void (QOPENGLF_APIENTRYP)(GLuint, GLenum, const void *, GLsizei);
+    using ProgramParameteri = void (QOPENGLF_APIENTRYP)(GLuint, GLenum, GLint);
+    using GetProgramiv = void (QOPENGLF_APIENTRYP)(GLuint, GLenum, GLint *);
+
+    QString getFilePath(const QByteArray &key) const;
+
+    const QString directory;
+
+    QByteArray driverIdentity;
+
+    GetProgramBinary getProgramBinary = nullptr;
+    ProgramBinary programBinary = nullptr;
+    ProgramParameteri programParameteri = nullptr;
+    GetProgramiv getProgramiv = nullptr;
+};
+
+} //namespace ShaderProgramCache
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <QGLShaderProgram>
+#include <QImage>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLVertexArrayObject>
+
+#include "FrameStatistics.hpp"
+
+namespace StatisticsOverlay {
+
+/* Shows frame times in the top left corner. The text is painted into an image on the CPU and
+   drawn as a textured quad, which leaves the GL state of the scene alone. */
+class StatisticsOverlay final {
+public:
+    StatisticsOverlay() = default;
+    ~StatisticsOverlay() = default;
+
+    StatisticsOverlay(const StatisticsOverlay &)            = delete;
+    StatisticsOverlay(StatisticsOverlay &&)                 = delete;
+    StatisticsOverlay &operator=(const StatisticsOverlay &) = delete;
+    StatisticsOverlay &operator=(StatisticsOverlay &&)      = delete;
+
+    void initialize();
+
+    /* Repaints the text, which is cheap enough to do a few times per second but not every frame.
+       The status line goes under the times unless it is empty. */
+    void update(const FrameStatistics::FrameTimes &mean, const QString &status);
+
+    void draw();
+
+private:
+    constexpr static int MARGIN = 8;
+
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+
+    std::unique_ptr<QGLShaderProgram> program;
+    /* Has no attributes, since the corners of the quad are generated from gl_VertexID. */
+    QOpenGLVertexArrayObject vertexArray;
+
+    QImage image;
+    GLuint texture = 0;
+};
+
+} //namespace StatisticsOverlay
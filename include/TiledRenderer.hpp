@@ -0,0 +1,49 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+#include <QMatrix4x4>
+#include <QOpenGLFunctions_3_3_Core>
+
+namespace TiledRenderer {
+
+/* Renders images larger than the framebuffer limits by drawing the scene tile by tile through
+   sub-frusta of the full view into an offscreen framebuffer. A full-width strip of tiles is
+   written out at a time, so only one strip is ever held in memory. */
+class TiledRenderer final {
+public:
+    /* The side of a tile, unless the driver allows less. */
+    constexpr static int TILE_SIZE = 1024;
+
+    TiledRenderer() = default;
+    ~TiledRenderer() = default;
+
+    TiledRenderer(const TiledRenderer &)            = delete;
+    TiledRenderer(TiledRenderer &&)                 = delete;
+    TiledRenderer &operator=(const TiledRenderer &) = delete;
+    TiledRenderer &operator=(TiledRenderer &&)      = delete;
+
+    void initialize();
+
+    /* Draws the image of the given size seen through matrix, whose aspect ratio should be
+       width / height, to a PNG file. drawFunc draws the scene with the matrix of a tile into
+       the bound framebuffer and viewport. Throws std::runtime_error if the file cannot be
+       written. */
+    void render(const QMatrix4x4 &matrix, int width, int height, const std::string &filename,
+                const std::function<void (const QMatrix4x4 &tileMatrix)> &drawFunc);
+
+    /* Narrows matrix to the pixels [x, x + tileWidth) x [y, y + tileHeight) of an image of the
+       given size, counted from its lower left corner like the GL window coordinates. */
+    static QMatrix4x4 getTileMatrix(const QMatrix4x4 &matrix, int width, int height,
+                                    int x, int y, int tileWidth, int tileHeight);
+
+private:
+    QOpenGLFunctions_3_3_Core *functions = nullptr;
+    int tileSize = TILE_SIZE;
+
+    std::vector<uint8_t> tilePixels;
+    std::vector<uint8_t> strip;
+};
+
+} //namespace TiledRenderer
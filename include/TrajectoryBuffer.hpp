@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "Model/Model.hpp"
+
+namespace TrajectoryBuffer {
+
+/* Converts points to normalised float triples, the layout the vertex buffer expects. */
+void convertAndNormalize(const Model::Point *points, size_t count, float normalizeConstant, float *out);
+
+class TrajectoryBuffer final {
+public:
+    explicit TrajectoryBuffer(size_t capacity);
+
+    /* Wraps size points owned elsewhere, e.g. a mapped file, which the deleter of points releases. */
+    TrajectoryBuffer(std::shared_ptr<float> points, size_t size);
+    ~TrajectoryBuffer() = default;
+
+    TrajectoryBuffer(const TrajectoryBuffer &)            = delete;
+    TrajectoryBuffer(TrajectoryBuffer &&)                 = default;
+    TrajectoryBuffer &operator=(const TrajectoryBuffer &) = delete;
+    TrajectoryBuffer &operator=(TrajectoryBuffer &&)      = default;
+
+    void append(const Model::Point *points, size_t count, float normalizeConstant);
+
+    const float *data() const;
+
+    size_t size() const;
+    size_t capacity() const;
+
+private:
+    std::shared_ptr<float> coordinates;
+
+    size_t pointsSize;
+    size_t pointsCapacity;
+};
+
+/* A freshly computed range of one locus. The producer never writes the range again,
+   so the consumer may read it without further synchronisation. */
+struct TrajectoryChunk {
+    size_t runId;
+    size_t locusIndex;
+    size_t locusNumber;
+
+    std::shared_ptr<const TrajectoryBuffer> buffer;
+    size_t offset;
+    size_t count;
+
+    bool last;
+};
+
+} //namespace TrajectoryBuffer
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "TrajectoryBuffer.hpp"
+
+namespace TrajectoryCache {
+
+/* Keeps recently computed trajectories in memory, evicting the least recently used ones
+   once their total size exceeds the budget. Safe to use from several threads. */
+class TrajectoryCache final {
+public:
+    explicit TrajectoryCache(size_t memoryBudget);
+    ~TrajectoryCache() = default;
+
+    TrajectoryCache(const TrajectoryCache &)            = delete;
+    TrajectoryCache(TrajectoryCache &&)                 = delete;
+    TrajectoryCache &operator=(const TrajectoryCache &) = delete;
+    TrajectoryCache &operator=(TrajectoryCache &&)      = delete;
+
+    /* Returns nullptr on a miss. */
+    std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> find(const std::string &key);
+
+    void insert(const std::string &key, std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> buffer);
+
+    void setMemoryBudget(size_t memoryBudget);
+
+    size_t memoryUsage() const;
+    size_t size() const;
+
+private:
+    using Entry = std::pair<std::string, std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer>>;
+
+    static size_t getMemorySize(const TrajectoryBuffer::TrajectoryBuffer &buffer);
+
+    void evict();
+
+    mutable std::mutex mutex;
+
+    std::list<Entry> entries;
+    std::unordered_map<std::string, std::list<Entry>::iterator> entriesByKey;
+
+    size_t budget;
+    size_t usage;
+};
+
+} //namespace TrajectoryCache
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "TrajectoryBuffer.hpp"
+
+namespace TrajectoryDiskCache {
+
+/* Stores finished trajectories as files of normalised float triples preceded by a small
+   header, so that a hit is served by mapping the file without any parsing or copying.
+   Once the directory outgrows the budget, the least recently used files are removed. */
+class TrajectoryDiskCache final {
+public:
+    TrajectoryDiskCache(std::string directory, size_t diskBudget);
+    ~TrajectoryDiskCache() = default;
+
+    TrajectoryDiskCache(const TrajectoryDiskCache &)            = delete;
+    TrajectoryDiskCache(TrajectoryDiskCache &&)                 = delete;
+    TrajectoryDiskCache &operator=(const TrajectoryDiskCache &) = delete;
+    TrajectoryDiskCache &operator=(TrajectoryDiskCache &&)      = delete;
+
+    /* Returns nullptr on a miss or when the file is not a valid entry for key. */
+    std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> find(const std::string &key) const;
+
+    void store(const std::string &key, const TrajectoryBuffer::TrajectoryBuffer &buffer);
+
+    void setDiskBudget(size_t diskBudget);
+
+private:
+    std::string getFilePath(const std::string &key) const;
+
+    void evict();
+
+    const std::string directory;
+
+    std::mutex mutex;
+    size_t budget;
+};
+
+} //namespace TrajectoryDiskCache
@@ -1,22 +1,30 @@
 #pragma once
 
 #include <QWidget>
+#include <QElapsedTimer>
 #include <QSlider>
+#include <QTimer>
 #include <QVector>
 #include <QVector3D>
 
+#include <atomic>
+#include <memory>
+
 #include "DynamicSystems/DynamicSystem.hpp"
 #include "Preferences.hpp"
 #include "WindowPreferences.hpp"
 #include "DynamicSystemWrapper.hpp"
-#include "StoppableTask.hpp"
+#include "JobSystem.hpp"
+#include "TrajectoryBuffer.hpp"
+#include "LockFreeQueue.hpp"
+#include "RunDescription.hpp"
+#include "TrajectoryCache.hpp"
+#include "TrajectoryDiskCache.hpp"
 
 namespace Ui {
 class Window;
 }
 
-class CountPointsTask;
-
 class Window : public QWidget {
     Q_OBJECT
 
@@ -25,8 +33,6 @@ public:
     ~Window();
 
 public slots:
-    void updateOpenGLWidget(QVector<QVector3D>);
-
     void updateVideoRecordingState();
     void slot_restart_button();
     void slot_time_slider(int);
@@ -41,51 +47,79 @@ protected:
     void keyReleaseEvent(QKeyEvent *event) override;
 
 private:
-    friend class CountPointsTask;
     void afterCountPointsUIUpdate();
 
+    RunDescription::RunDescription captureRunDescription();
+
+    void consumeComputedChunks();
+    void updateComputationState();
+    void advanceSlider();
+
     void insertConstants(const std::vector<std::pair<std::string, std::vector<long double>>> &);
 
     void insertExpressions(std::array<std::string_view, 3> array, bool);
 
     void addNewConstant(const std::string_view &name, long double initValue);
 
-    using LambdaPushBackAction = decltype(DynamicSystemWrapper_n::getPushBackAndNormalizeLambda(std::declval<QVector<QVector3D> &>(),
-                                                                                                std::declval<float>()));
-    using DynamicSystemWrapper = DynamicSystems::DynamicSystem<LambdaPushBackAction>;
+    using DynamicSystemWrapper = DynamicSystems::DynamicSystem;
 
     static DynamicSystemWrapper getCustomSystem(const std::array<std::string, 3> &);
 
-    std::map<QString, DynamicSystemWrapper> dynamicSystems;
+    std::map<QString, std::shared_ptr<const DynamicSystemWrapper>> dynamicSystems;
 
     int timeValue = 0;
+    QElapsedTimer sliderClock;
 
     bool pauseState = false;
 
     Preferences::Preferences prefs;
 
+    constexpr static size_t CHUNKS_QUEUE_CAPACITY = 1024;
+    constexpr static size_t MAX_CHUNKS_PER_UPDATE = 64;
+
+    std::atomic<size_t> currentRunId;
+
+    /* The time on screen in live mode, which paces the live computation. */
+    bool liveMode = false;
+    std::atomic<size_t> displayedTime;
+
+    LockFreeQueue::LockFreeQueue<TrajectoryBuffer::TrajectoryChunk> computedChunks;
+    TrajectoryCache::TrajectoryCache trajectoryCache;
+    TrajectoryDiskCache::TrajectoryDiskCache trajectoryDiskCache;
+
     QTimer *sliderTimer;
 
     WindowPreferences *windowPreferences;
     Ui::Window *ui;
-    CountPointsTask *task;
-};
 
+    JobSystem::JobHandle countPointsJob;
+    JobSystem::WorkerPool workerPool;
+};
 
-class CountPointsTask : public StoppableTask {
-    Q_OBJECT
 
-signals:
-    void updater(QVector<QVector3D>);
+class CountPointsTask final {
 public:
-    CountPointsTask(Window& wind_);
+    using ChunksQueue = LockFreeQueue::LockFreeQueue<TrajectoryBuffer::TrajectoryChunk>;
 
-    void run() override;
+    /* How far a live computation may run ahead of the displayed time. */
+    constexpr static size_t LIVE_LEAD_POINTS = 4096;
+
+    CountPointsTask(const RunDescription::RunDescription &description_, size_t runId_,
+                    ChunksQueue &chunks_, TrajectoryCache::TrajectoryCache &cache_,
+                    TrajectoryDiskCache::TrajectoryDiskCache &diskCache_,
+                    const std::atomic<size_t> &displayedTime_);
+
+    void run(const JobSystem::CancellationToken &token);
 
-public slots:
-    void afterRun() override {
-        wind.afterCountPointsUIUpdate();
-    }
 private:
-    Window& wind;
+    bool pushChunk(TrajectoryBuffer::TrajectoryChunk &&chunk, const JobSystem::CancellationToken &token);
+
+    void runLive(const JobSystem::CancellationToken &token);
+
+    const RunDescription::RunDescription &description;
+    const size_t runId;
+    ChunksQueue &chunks;
+    TrajectoryCache::TrajectoryCache &cache;
+    TrajectoryDiskCache::TrajectoryDiskCache &diskCache;
+    const std::atomic<size_t> &displayedTime;
 };
@@ -0,0 +1,17 @@
+layout(std140) uniform FrameState {
+    highp mat4 matrix;
+    highp vec4 colors[20];
+
+    highp int regionSize;
+    highp int trajectoriesNumber;
+    highp int colorsNumber;
+    highp float startTailSize;
+    highp float finalTailSize;
+    highp float interpolationDist;
+    highp int splineSegments;
+    highp int blockSize;
+    highp int blocksPerRegion;
+    highp int currentTime;
+    highp int tailPointsNumber;
+    highp int ringSize;
+};
@@ -129,13 +129,7 @@ void Camera::setDefault() {
 
 
 KeyboardAndMouseController::KeyboardAndMouseController() :
-    prefs{&Preferences::defaultPreferences} {
-
-    timer = new QTimer(this);
-    timer->setInterval(1);
-    connect(timer, SIGNAL(timeout()), this, SLOT(updateKeys()));
-    timer->start();
-}
+    prefs{&Preferences::defaultPreferences} {}
 
 void KeyboardAndMouseController::setPreferences(const Preferences::Preferences *prefs_) {
     prefs = prefs_;
@@ -157,28 +151,24 @@ void KeyboardAndMouseController::recalculatePerspective(int width, int height) {
     camera.recalculatePerspective(width, height);
 }
 
-void KeyboardAndMouseController::applyKeyPressEvent(QKeyEvent *event) {
-    keys.insert(event->key());
-    event->accept();
+void KeyboardAndMouseController::applyKeyPress(int key) {
+    keys.insert(key);
 }
 
-void KeyboardAndMouseController::applyKeyReleaseEvent(QKeyEvent *event) {
-    keys.remove(event->key());
-    event->accept();
+void KeyboardAndMouseController::applyKeyRelease(int key) {
+    keys.remove(key);
 }
 
-void KeyboardAndMouseController::applyMousePressEvent(QMouseEvent *event) {
-    camera.resetMousePosition(event->pos());
-    event->accept();
+void KeyboardAndMouseController::applyMousePress(const QPoint &position) {
+    camera.resetMousePosition(position);
 }
 
-void KeyboardAndMouseController::applyMouseMoveEvent(QMouseEvent *event) {
-    camera.recalculateTarget(event->pos(), prefs->camera.sensitivity);
-    event->accept();
+void KeyboardAndMouseController::applyMouseMove(const QPoint &position) {
+    camera.recalculateTarget(position, prefs->camera.sensitivity);
 }
 
-void KeyboardAndMouseController::updateKeys() {
-    float force = 1;
+void KeyboardAndMouseController::update(float elapsedMilliseconds) {
+    float force = elapsedMilliseconds;
     if (keys.contains(Qt::Key_Shift)) {
         force *= 2;
     }
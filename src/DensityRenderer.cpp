@@ -0,0 +1,86 @@
+#include <QOpenGLContext>
+
+#include "DensityRenderer.hpp"
+
+namespace DensityRenderer {
+
+void DensityRenderer::initialize() {
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+
+    resolveProgram = std::make_unique<QGLShaderProgram>();
+    resolveProgram->addShaderFromSourceFile(QGLShader::Vertex, ":/FullScreen.vsh");
+    resolveProgram->addShaderFromSourceFile(QGLShader::Fragment, ":/DensityResolve.fsh");
+    resolveProgram->link();
+
+    resolveVertexArray.create();
+    functions->glGenFramebuffers(1, &framebuffer);
+}
+
+/* 32-bit channels keep counting single hits long after 16-bit ones would have stopped at 2048. */
+void DensityRenderer::resize(GLsizei newWidth, GLsizei newHeight) {
+    if (newWidth == width && newHeight == height && densityTexture != 0) {
+        return;
+    }
+    width = newWidth;
+    height = newHeight;
+
+    if (densityTexture != 0) {
+        functions->glDeleteTextures(1, &densityTexture);
+    }
+    functions->glGenTextures(1, &densityTexture);
+    functions->glBindTexture(GL_TEXTURE_2D, densityTexture);
+    functions->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    functions->glBindTexture(GL_TEXTURE_2D, 0);
+
+    functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    functions->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, densityTexture, 0);
+}
+
+void DensityRenderer::startAccumulation() {
+    functions->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    functions->glGetIntegerv(GL_VIEWPORT, previousViewport);
+    functions->glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+    depthTestEnabled = functions->glIsEnabled(GL_DEPTH_TEST);
+
+    resize(previousViewport[2], previousViewport[3]);
+    functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffer);
+    functions->glViewport(0, 0, width, height);
+
+    functions->glClearColor(0, 0, 0, 0);
+    functions->glClear(GL_COLOR_BUFFER_BIT);
+
+    functions->glDisable(GL_DEPTH_TEST);
+    functions->glEnable(GL_BLEND);
+    functions->glBlendFunc(GL_ONE, GL_ONE);
+}
+
+void DensityRenderer::resolve(float exposure) {
+    functions->glDisable(GL_BLEND);
+    if (depthTestEnabled) {
+        functions->glEnable(GL_DEPTH_TEST);
+    }
+
+    functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    functions->glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    functions->glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+    functions->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    functions->glActiveTexture(GL_TEXTURE0);
+    functions->glBindTexture(GL_TEXTURE_2D, densityTexture);
+
+    resolveProgram->bind();
+    resolveProgram->setUniformValue("density", 0);
+    resolveProgram->setUniformValue("exposure", exposure);
+
+    resolveVertexArray.bind();
+    functions->glDrawArrays(GL_TRIANGLES, 0, 3);
+    resolveVertexArray.release();
+
+    resolveProgram->release();
+    functions->glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+} //namespace DensityRenderer
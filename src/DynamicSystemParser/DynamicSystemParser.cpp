@@ -45,4 +45,21 @@ ParserDerivativesWrapper parseExpressions(const std::string &xExpr, const std::s
     return ParserDerivativesWrapper{std::move(variableArray), std::move(xFunc), std::move(yFunc), std::move(zFunc)};
 }
 
-} // namespace DynamicSystemParser::Impl
\ No newline at end of file
+} // namespace DynamicSystemParser::Impl
+
+
+namespace DynamicSystemParser {
+
+DynamicSystems::DynamicSystem getDynamicSystem(
+        const std::string &attractorName,
+        const std::array<std::string, 3> &formulae,
+        const std::vector<std::string> &variablesNames,
+        const std::vector<std::pair<std::string, std::vector<long double>>> &interestingConstants,
+        const std::map<std::string, long double> &customConstVariables) {
+    using LambdaDerivatives = decltype(std::declval<Impl::ParserDerivativesWrapper>().operator()(std::declval<const std::vector<long double> &>()));
+    using DynamicSystemInternal = DynamicSystems::DynamicSystemInternal<LambdaDerivatives>;
+    return DynamicSystems::DynamicSystem{attractorName, formulae, variablesNames, interestingConstants,
+                                         DynamicSystemInternal{Impl::parseExpressions(formulae[0], formulae[1], formulae[2], customConstVariables)}};
+}
+
+} // namespace DynamicSystemParser
\ No newline at end of file
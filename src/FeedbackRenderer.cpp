@@ -0,0 +1,137 @@
+#include <QOpenGLContext>
+
+#include "FeedbackRenderer.hpp"
+
+namespace FeedbackRenderer {
+
+void FeedbackRenderer::initialize() {
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+
+    fadeProgram = std::make_unique<QGLShaderProgram>();
+    fadeProgram->addShaderFromSourceFile(QGLShader::Vertex, ":/FullScreen.vsh");
+    fadeProgram->addShaderFromSourceFile(QGLShader::Fragment, ":/FeedbackFade.fsh");
+    fadeProgram->link();
+
+    reprojectProgram = std::make_unique<QGLShaderProgram>();
+    reprojectProgram->addShaderFromSourceFile(QGLShader::Vertex, ":/FeedbackReproject.vsh");
+    reprojectProgram->addShaderFromSourceFile(QGLShader::Fragment, ":/FeedbackReproject.fsh");
+    reprojectProgram->link();
+
+    emptyVertexArray.create();
+    for (auto &target : targets) {
+        functions->glGenFramebuffers(1, &target.framebuffer);
+    }
+}
+
+void FeedbackRenderer::reset() {
+    valid = false;
+}
+
+/* Half floats keep the faded colors from banding, a float depth keeps reprojection precise. */
+void FeedbackRenderer::resize(GLsizei newWidth, GLsizei newHeight) {
+    if (newWidth == width && newHeight == height && targets[0].colorTexture != 0) {
+        return;
+    }
+    width = newWidth;
+    height = newHeight;
+    valid = false;
+
+    for (auto &target : targets) {
+        if (target.colorTexture != 0) {
+            functions->glDeleteTextures(1, &target.colorTexture);
+            functions->glDeleteTextures(1, &target.depthTexture);
+        }
+
+        functions->glGenTextures(1, &target.colorTexture);
+        functions->glBindTexture(GL_TEXTURE_2D, target.colorTexture);
+        functions->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        functions->glGenTextures(1, &target.depthTexture);
+        functions->glBindTexture(GL_TEXTURE_2D, target.depthTexture);
+        functions->glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0,
+                                GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+        functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, target.framebuffer);
+        functions->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D,
+                                          target.colorTexture, 0);
+        functions->glFramebufferTexture2D(GL_DRAW_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D,
+                                          target.depthTexture, 0);
+    }
+    functions->glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool FeedbackRenderer::startFrame(const QMatrix4x4 &matrix, float fade) {
+    functions->glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &previousFramebuffer);
+    functions->glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &previousReadFramebuffer);
+    functions->glGetIntegerv(GL_VIEWPORT, previousViewport);
+    functions->glGetFloatv(GL_COLOR_CLEAR_VALUE, previousClearColor);
+    depthTestEnabled = functions->glIsEnabled(GL_DEPTH_TEST);
+
+    resize(previousViewport[2], previousViewport[3]);
+
+    const Target &previous = targets[currentTarget];
+    currentTarget ^= 1;
+    functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targets[currentTarget].framebuffer);
+    functions->glViewport(0, 0, width, height);
+
+    functions->glClearColor(0, 0, 0, 0);
+    functions->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    functions->glEnable(GL_DEPTH_TEST);
+
+    bool carried = valid;
+    if (carried) {
+        functions->glActiveTexture(GL_TEXTURE0);
+        functions->glBindTexture(GL_TEXTURE_2D, previous.colorTexture);
+        functions->glActiveTexture(GL_TEXTURE1);
+        functions->glBindTexture(GL_TEXTURE_2D, previous.depthTexture);
+
+        /* A still camera needs a plain copy, a moving one has every pixel moved as a point. */
+        bool moved = matrix != previousMatrix;
+        QGLShaderProgram &program = moved ? *reprojectProgram : *fadeProgram;
+        program.bind();
+        program.setUniformValue("previousColor", 0);
+        program.setUniformValue("previousDepth", 1);
+        program.setUniformValue("fade", fade);
+
+        emptyVertexArray.bind();
+        if (moved) {
+            program.setUniformValue("reprojection", matrix * previousMatrix.inverted());
+            functions->glDrawArrays(GL_POINTS, 0, width * height);
+        } else {
+            functions->glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+        emptyVertexArray.release();
+        program.release();
+
+        functions->glBindTexture(GL_TEXTURE_2D, 0);
+        functions->glActiveTexture(GL_TEXTURE0);
+        functions->glBindTexture(GL_TEXTURE_2D, 0);
+    }
+
+    valid = true;
+    previousMatrix = matrix;
+    return carried;
+}
+
+void FeedbackRenderer::finishFrame() {
+    functions->glBindFramebuffer(GL_READ_FRAMEBUFFER, targets[currentTarget].framebuffer);
+    functions->glBindFramebuffer(GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(previousFramebuffer));
+    functions->glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+    functions->glBlitFramebuffer(0, 0, width, height,
+                                 previousViewport[0], previousViewport[1],
+                                 previousViewport[0] + width, previousViewport[1] + height,
+                                 GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    functions->glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(previousReadFramebuffer));
+    functions->glClearColor(previousClearColor[0], previousClearColor[1], previousClearColor[2], previousClearColor[3]);
+
+    if (!depthTestEnabled) {
+        functions->glDisable(GL_DEPTH_TEST);
+    }
+}
+
+} //namespace FeedbackRenderer
@@ -0,0 +1,136 @@
+#include <algorithm>
+
+#include "FrameStatistics.hpp"
+
+namespace FrameStatistics {
+
+const char *getSectionName(Section section) {
+    switch (section) {
+    case Section::Camera:
+        return "camera";
+    case Section::Slider:
+        return "slider";
+    case Section::Clear:
+        return "clear";
+    case Section::Draw:
+        return "draw";
+    case Section::Readback:
+        return "readback";
+    case Section::Frame:
+        return "frame";
+    default:
+        return "";
+    }
+}
+
+FrameTimes::FrameTimes() {
+    cpu.fill(-1);
+    gpu.fill(-1);
+}
+
+FrameStatistics::FrameStatistics(size_t capacity_) : capacity{capacity_} {}
+
+void FrameStatistics::add(const FrameTimes &times) {
+    frames.push_back(times);
+    while (frames.size() > capacity) {
+        frames.pop_front();
+    }
+}
+
+void FrameStatistics::clear() {
+    frames.clear();
+}
+
+size_t FrameStatistics::size() const {
+    return frames.size();
+}
+
+const FrameTimes &FrameStatistics::operator[](size_t index) const {
+    return frames[index];
+}
+
+FrameTimes FrameStatistics::getMean(size_t framesNumber) const {
+    std::array<double, SECTIONS_NUMBER> cpuSums{}, gpuSums{};
+    std::array<size_t, SECTIONS_NUMBER> cpuCounts{}, gpuCounts{};
+
+    size_t first = frames.size() - std::min(framesNumber, frames.size());
+    for (size_t i = first; i < frames.size(); i++) {
+        for (size_t section = 0; section < SECTIONS_NUMBER; section++) {
+            if (frames[i].cpu[section] >= 0) {
+                cpuSums[section] += frames[i].cpu[section];
+                cpuCounts[section]++;
+            }
+            if (frames[i].gpu[section] >= 0) {
+                gpuSums[section] += frames[i].gpu[section];
+                gpuCounts[section]++;
+            }
+        }
+    }
+
+    FrameTimes mean;
+    if (!frames.empty()) {
+        mean.time = frames.back().time;
+    }
+    for (size_t section = 0; section < SECTIONS_NUMBER; section++) {
+        if (cpuCounts[section] != 0) {
+            mean.cpu[section] = cpuSums[section] / cpuCounts[section];
+        }
+        if (gpuCounts[section] != 0) {
+            mean.gpu[section] = gpuSums[section] / gpuCounts[section];
+        }
+    }
+    return mean;
+}
+
+void FrameStatistics::writeCsv(std::ostream &stream) const {
+    stream << "time";
+    for (const char *kind : {"cpu_", "gpu_"}) {
+        for (size_t section = 0; section < SECTIONS_NUMBER; section++) {
+            stream << ',' << kind << getSectionName(static_cast<Section>(section));
+        }
+    }
+    stream << '\n';
+
+    for (const auto &frame : frames) {
+        stream << frame.time;
+        for (const auto *values : {&frame.cpu, &frame.gpu}) {
+            for (double value : *values) {
+                stream << ',';
+                if (value >= 0) {
+                    stream << value;
+                }
+            }
+        }
+        stream << '\n';
+    }
+}
+
+void FrameStatistics::writeJson(std::ostream &stream) const {
+    auto writeSections = [&stream](const std::array<double, SECTIONS_NUMBER> &values) {
+        stream << '{';
+        bool first = true;
+        for (size_t section = 0; section < SECTIONS_NUMBER; section++) {
+            if (values[section] < 0) {
+                continue;
+            }
+            if (!first) {
+                stream << ", ";
+            }
+            first = false;
+            stream << '"' << getSectionName(static_cast<Section>(section)) << "\": " << values[section];
+        }
+        stream << '}';
+    };
+
+    stream << "[\n";
+    for (size_t i = 0; i < frames.size(); i++) {
+        stream << "  {\"time\": " << frames[i].time << ", \"cpu\": ";
+        writeSections(frames[i].cpu);
+        stream << ", \"gpu\": ";
+        writeSections(frames[i].gpu);
+        stream << (i + 1 < frames.size() ? "},\n" : "}\n");
+    }
+    stream << "]\n";
+}
+
+} //namespace FrameStatistics
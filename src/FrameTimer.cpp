@@ -0,0 +1,118 @@
+#include <QOpenGLContext>
+
+#include "FrameTimer.hpp"
+
+namespace FrameTimer {
+
+using FrameStatistics::Section;
+
+void FrameTimer::initialize() {
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+
+    for (auto &frame : frames) {
+        functions->glGenQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+    }
+}
+
+bool FrameTimer::hasGpuTime(Section section) {
+    return section == Section::Clear || section == Section::Draw ||
+           section == Section::Readback || section == Section::Frame;
+}
+
+void FrameTimer::startFrame(double time) {
+    auto &frame = frames[(oldestFrame + pendingNumber) % FRAMES_IN_FLIGHT];
+    frame.times = FrameStatistics::FrameTimes{};
+    frame.times.time = time;
+    frame.queried.fill(false);
+    frameStarted = true;
+
+    begin(Section::Frame);
+}
+
+void FrameTimer::cancelFrame() {
+    frameStarted = false;
+}
+
+void FrameTimer::begin(Section section) {
+    if (!frameStarted) {
+        return;
+    }
+    auto index = static_cast<size_t>(section);
+    starts[index] = Clock::now();
+
+    if (hasGpuTime(section)) {
+        auto &frame = frames[(oldestFrame + pendingNumber) % FRAMES_IN_FLIGHT];
+        functions->glQueryCounter(frame.queries[2 * index], GL_TIMESTAMP);
+    }
+}
+
+void FrameTimer::end(Section section) {
+    if (!frameStarted) {
+        return;
+    }
+    auto index = static_cast<size_t>(section);
+    auto &frame = frames[(oldestFrame + pendingNumber) % FRAMES_IN_FLIGHT];
+    frame.times.cpu[index] = std::chrono::duration<double, std::milli>(Clock::now() - starts[index]).count();
+
+    if (hasGpuTime(section)) {
+        functions->glQueryCounter(frame.queries[2 * index + 1], GL_TIMESTAMP);
+        frame.queried[index] = true;
+    }
+}
+
+void FrameTimer::setCpuTime(Section section, double milliseconds) {
+    if (!frameStarted || milliseconds < 0) {
+        return;
+    }
+    frames[(oldestFrame + pendingNumber) % FRAMES_IN_FLIGHT].times.cpu[static_cast<size_t>(section)] = milliseconds;
+}
+
+/* The frame section ends last, so once its timestamp is available all the others are. */
+bool FrameTimer::collect(PendingFrame &frame, bool wait) {
+    auto frameIndex = static_cast<size_t>(Section::Frame);
+    if (!wait) {
+        GLuint available = GL_FALSE;
+        functions->glGetQueryObjectuiv(frame.queries[2 * frameIndex + 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (available == GL_FALSE) {
+            return false;
+        }
+    }
+
+    for (size_t section = 0; section < FrameStatistics::SECTIONS_NUMBER; section++) {
+        if (!frame.queried[section]) {
+            continue;
+        }
+        GLuint64 start = 0;
+        GLuint64 finish = 0;
+        functions->glGetQueryObjectui64v(frame.queries[2 * section], GL_QUERY_RESULT, &start);
+        functions->glGetQueryObjectui64v(frame.queries[2 * section + 1], GL_QUERY_RESULT, &finish);
+        frame.times.gpu[section] = static_cast<double>(finish - start) / 1e6;
+    }
+    return true;
+}
+
+/* The slot of the next frame must be free, so the oldest frame is waited for when all are taken. */
+size_t FrameTimer::finishFrame(FrameStatistics::FrameStatistics &statistics) {
+    if (!frameStarted) {
+        return 0;
+    }
+    end(Section::Frame);
+    frameStarted = false;
+    pendingNumber++;
+
+    size_t collected = 0;
+    while (pendingNumber > 0) {
+        auto &frame = frames[oldestFrame];
+        if (!collect(frame, pendingNumber == FRAMES_IN_FLIGHT)) {
+            break;
+        }
+        statistics.add(frame.times);
+        oldestFrame = (oldestFrame + 1) % FRAMES_IN_FLIGHT;
+        pendingNumber--;
+        collected++;
+    }
+    return collected;
+}
+
+} //namespace FrameTimer
@@ -0,0 +1,48 @@
+#include <algorithm>
+
+#include "Frustum.hpp"
+
+namespace Frustum {
+
+void BoundingBox::extend(const QVector3D &point) {
+    if (empty) {
+        minimum = point;
+        maximum = point;
+        empty = false;
+        return;
+    }
+
+    minimum = QVector3D(std::min(minimum.x(), point.x()), std::min(minimum.y(), point.y()),
+                        std::min(minimum.z(), point.z()));
+    maximum = QVector3D(std::max(maximum.x(), point.x()), std::max(maximum.y(), point.y()),
+                        std::max(maximum.z(), point.z()));
+}
+
+Frustum::Frustum(const QMatrix4x4 &matrix) {
+    QVector4D x = matrix.row(0);
+    QVector4D y = matrix.row(1);
+    QVector4D z = matrix.row(2);
+    QVector4D w = matrix.row(3);
+
+    planes = {w + x, w - x, w + y, w - y, w + z, w - z};
+}
+
+bool Frustum::intersects(const BoundingBox &box) const {
+    if (box.empty) {
+        return false;
+    }
+
+    /* The box is outside once its corner furthest along the plane normal is behind the plane. */
+    for (const auto &plane : planes) {
+        QVector4D corner(plane.x() >= 0 ? box.maximum.x() : box.minimum.x(),
+                         plane.y() >= 0 ? box.maximum.y() : box.minimum.y(),
+                         plane.z() >= 0 ? box.maximum.z() : box.minimum.z(),
+                         1);
+        if (QVector4D::dotProduct(plane, corner) < 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} //namespace Frustum
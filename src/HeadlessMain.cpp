@@ -0,0 +1,179 @@
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <QCommandLineParser>
+#include <QGuiApplication>
+
+#include "DynamicSystems/DynamicSystem.hpp"
+#include "DynamicSystemWrapper.hpp"
+#include "HeadlessRenderer.hpp"
+#include "Preferences.hpp"
+
+namespace {
+
+/* The distance of the camera from the origin, as at the start of the interactive view. */
+constexpr float CAMERA_DISTANCE = 5;
+
+struct Options final {
+    std::string systemName;
+    int constantsIndex = 0;
+    size_t locusNumber;
+    int pointsNumber;
+    size_t tailPointsNumber;
+    size_t time;
+    int width;
+    int height;
+    std::string stillName;
+    std::string videoName;
+    int framesNumber = 300;
+};
+
+/* Fails with std::runtime_error on values that are not numbers. */
+Options parseOptions(const QCoreApplication &app, const Preferences::Preferences &prefs) {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders dynamic systems to stills and videos without a display.");
+    parser.addHelpOption();
+    parser.addOptions({
+        {"system", "The name of the system to draw.", "name"},
+        {"constants", "The index of the interesting constants of the system.", "index", "0"},
+        {"loci", "The number of trajectories.", "number", QString::number(prefs.visualization.locusNumber)},
+        {"points", "The number of points of every trajectory.", "number", QString::number(prefs.model.pointsNumber)},
+        {"tail", "The number of drawn points before the time.", "number",
+         QString::number(prefs.visualization.tailPointsNumber)},
+        {"time", "The point up to which a still is drawn, the last one by default.", "point"},
+        {"width", "The width of the output.", "pixels", QString::number(prefs.video.width)},
+        {"height", "The height of the output.", "pixels", QString::number(prefs.video.height)},
+        {"still", "Saves a PNG still of the time.", "file"},
+        {"video", "Saves a video going around the system while the time runs to its end.", "file"},
+        {"frames", "The number of frames of the video.", "number", "300"},
+    });
+    parser.process(app);
+
+    auto getNumber = [&parser](const QString &name) {
+        bool valid = false;
+        long long value = parser.value(name).toLongLong(&valid);
+        if (!valid || value < 0) {
+            throw std::runtime_error("--" + name.toStdString() + " takes a non-negative number.");
+        }
+        return value;
+    };
+
+    Options options;
+    options.systemName = parser.value("system").toStdString();
+    options.constantsIndex = static_cast<int>(getNumber("constants"));
+    options.locusNumber = static_cast<size_t>(getNumber("loci"));
+    options.pointsNumber = static_cast<int>(getNumber("points"));
+    options.tailPointsNumber = static_cast<size_t>(getNumber("tail"));
+    options.time = parser.isSet("time") ? static_cast<size_t>(getNumber("time")) : options.pointsNumber;
+    options.width = static_cast<int>(getNumber("width"));
+    options.height = static_cast<int>(getNumber("height"));
+    options.stillName = parser.value("still").toStdString();
+    options.videoName = parser.value("video").toStdString();
+    options.framesNumber = static_cast<int>(getNumber("frames"));
+
+    if (options.pointsNumber == 0) {
+        throw std::runtime_error("--points takes a positive number.");
+    }
+    if (options.width == 0 || options.height == 0 || options.framesNumber == 0) {
+        throw std::runtime_error("The size of the output and the number of frames cannot be zero.");
+    }
+    if (options.stillName.empty() && options.videoName.empty()) {
+        throw std::runtime_error("Nothing to render: give --still or --video.");
+    }
+    return options;
+}
+
+const DynamicSystems::DynamicSystem &findSystem(const std::vector<DynamicSystems::DynamicSystem> &systems,
+                                                const std::string &name) {
+    if (name.empty()) {
+        return systems.front();
+    }
+    for (const auto &system : systems) {
+        if (system.getAttractorName() == name) {
+            return system;
+        }
+    }
+    throw std::runtime_error("There is no system named " + name + ".");
+}
+
+/* Starts the trajectories the way the window does, from points along the diagonal. */
+void computeTrajectories(HeadlessRenderer::HeadlessRenderer &renderer, const DynamicSystems::DynamicSystem &system,
+                         const std::vector<long double> &constants, const Options &options,
+                         const Preferences::Preferences &prefs) {
+    for (size_t i = 0; i < options.locusNumber; i++) {
+        long double offset = prefs.model.startPointDelta * i;
+        Model::Point point{prefs.model.startPoint.x + offset,
+                           prefs.model.startPoint.y + offset,
+                           prefs.model.startPoint.z + offset};
+
+        auto buffer = std::make_shared<TrajectoryBuffer::TrajectoryBuffer>(options.pointsNumber);
+        DynamicSystemWrapper_n::computeNormalized(system, *buffer, point, options.pointsNumber,
+                                                  prefs.model.deltaTime, constants, prefs.model.divNormalization);
+        renderer.addChunk({0, i, options.locusNumber, buffer, 0, buffer->size(), true});
+    }
+}
+
+/* One turn around the vertical axis, looking at the origin, while the time runs from the
+   start to the end of the trajectories. */
+QVector<VideoEncoder::FrameState> getOrbit(const Options &options) {
+    QVector<VideoEncoder::FrameState> states;
+    for (int frame = 0; frame < options.framesNumber; frame++) {
+        float angle = 2 * static_cast<float>(M_PI) * frame / options.framesNumber;
+        QVector3D position(CAMERA_DISTANCE * std::sin(angle), 0, CAMERA_DISTANCE * std::cos(angle));
+        size_t time = static_cast<size_t>(options.pointsNumber) * (frame + 1) / options.framesNumber;
+        states.push_back({position, -position, time});
+    }
+    return states;
+}
+
+void setDefaultEnvironment(const char *name, const char *value) {
+    if (qEnvironmentVariableIsEmpty(name)) {
+        qputenv(name, value);
+    }
+}
+
+} //namespace
+
+/* The renderer makes its context on the surfaceless EGL display and eglfs adopts it. Set up this
+   way, eglfs uses that display too and neither looks for a screen nor for input devices. */
+int main(int argc, char *argv[]) {
+    setDefaultEnvironment("QT_QPA_PLATFORM", "eglfs");
+    setDefaultEnvironment("QT_QPA_EGLFS_INTEGRATION", "none");
+    setDefaultEnvironment("QT_QPA_EGLFS_FB", "/dev/null");
+    setDefaultEnvironment("QT_QPA_EGLFS_DISABLE_INPUT", "1");
+    setDefaultEnvironment("EGL_PLATFORM", "surfaceless");
+    QGuiApplication app(argc, argv);
+
+    Preferences::Preferences prefs;
+    try {
+        Options options = parseOptions(app, prefs);
+        prefs.visualization.locusNumber = options.locusNumber;
+        prefs.visualization.tailPointsNumber = options.tailPointsNumber;
+        prefs.model.pointsNumber = options.pointsNumber;
+
+        auto systems = DynamicSystems::getDefaultSystems();
+        const auto &system = findSystem(systems, options.systemName);
+        const auto &constants = system.getInterestingConstants().at(static_cast<size_t>(options.constantsIndex)).second;
+
+        HeadlessRenderer::HeadlessRenderer renderer;
+        renderer.initialize();
+        renderer.setPreferences(&prefs);
+        computeTrajectories(renderer, system, constants, options, prefs);
+
+        if (!options.stillName.empty()) {
+            VideoEncoder::FrameState state{{0, 0, CAMERA_DISTANCE}, {0, 0, -CAMERA_DISTANCE}, options.time};
+            renderer.saveStill(state, options.width, options.height, options.stillName);
+        }
+        if (!options.videoName.empty()) {
+            renderer.saveVideo(getOrbit(options), options.width, options.height, options.videoName, [](int percent) {
+                std::cerr << "\r" << percent << "%" << std::flush;
+            });
+            std::cerr << std::endl;
+        }
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include <stdexcept>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QtPlatformHeaders/QEGLNativeContext>
+
+#include "Camera.hpp"
+#include "HeadlessRenderer.hpp"
+
+namespace HeadlessRenderer {
+
+/* The display stays initialised, the eglfs plugin shares it and terminates it on exit. */
+EglContext::~EglContext() {
+    if (context != nullptr) {
+        eglDestroyContext(display, context);
+    }
+}
+
+void EglContext::create() {
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+        eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay == nullptr) {
+        throw std::runtime_error("EGL cannot open platform displays.");
+    }
+    display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+        throw std::runtime_error("There is no surfaceless EGL display.");
+    }
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        throw std::runtime_error("EGL does not support desktop OpenGL.");
+    }
+
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configsNumber = 0;
+    if (!eglChooseConfig(display, configAttributes, &config, 1, &configsNumber) || configsNumber == 0) {
+        throw std::runtime_error("EGL has no pbuffer configuration for OpenGL.");
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION, 3,
+        EGL_CONTEXT_MINOR_VERSION, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttributes);
+    if (context == EGL_NO_CONTEXT) {
+        throw std::runtime_error("OpenGL 3.3 is not supported.");
+    }
+}
+
+QVariant EglContext::getNativeHandle() const {
+    return QVariant::fromValue(QEGLNativeContext(context, display));
+}
+
+/* The GL objects of the members are destroyed with the context current. */
+HeadlessRenderer::~HeadlessRenderer() {
+    if (context.isValid()) {
+        context.makeCurrent(&surface);
+    }
+}
+
+/* The same state as the widget sets up, but for point smoothing, which the core profile lacks. */
+void HeadlessRenderer::initialize() {
+    eglContext.create();
+    context.setNativeHandle(eglContext.getNativeHandle());
+    if (!context.create()) {
+        throw std::runtime_error("The Qt platform plugin cannot adopt an EGL context, it has to be eglfs.");
+    }
+    /* The pbuffer has to match the configuration of the adopted context. */
+    surface.setFormat(context.format());
+    surface.create();
+    if (!surface.isValid() || !context.makeCurrent(&surface)) {
+        throw std::runtime_error("Could not create an offscreen OpenGL surface.");
+    }
+    auto *functions = context.versionFunctions<QOpenGLFunctions_3_3_Core>();
+    if (functions == nullptr || !functions->initializeOpenGLFunctions()) {
+        throw std::runtime_error("OpenGL 3.3 is not supported.");
+    }
+
+    functions->glEnable(GL_DEPTH_TEST);
+    functions->glEnable(GL_CULL_FACE);
+    functions->glEnable(GL_VERTEX_PROGRAM_POINT_SIZE);
+    functions->glClearColor(0, 0, 0, 1);
+
+    locusController.initialize();
+    tiledRenderer.initialize();
+}
+
+void HeadlessRenderer::setPreferences(const Preferences::Preferences *prefs) {
+    locusController.setPreferences(prefs);
+}
+
+void HeadlessRenderer::addChunk(const TrajectoryBuffer::TrajectoryChunk &chunk) {
+    locusController.addChunk(chunk);
+}
+
+void HeadlessRenderer::saveStill(const VideoEncoder::FrameState &state, int width, int height,
+                                 const std::string &filename) {
+    Camera::Camera camera;
+    camera.setPosition(state.position);
+    camera.setTarget(state.target);
+    camera.recalculatePerspective(width, height);
+
+    tiledRenderer.render(camera.getMatrix(), width, height, filename, [this, time = state.time](const QMatrix4x4 &matrix) {
+        locusController.draw(matrix, time);
+    });
+}
+
+void HeadlessRenderer::saveVideo(const QVector<VideoEncoder::FrameState> &states, int width, int height,
+                                 const std::string &filename, std::function<void (int)> progress) {
+    videoEncoder.startEncoding(width, height, filename.c_str());
+    for (const auto &state : states) {
+        videoEncoder.writeState(state);
+    }
+    videoEncoder.endEncoding([this](const QMatrix4x4 &matrix, size_t time) {
+        locusController.draw(matrix, time);
+    }, std::move(progress));
+    videoEncoder.endEncoding();
+}
+
+} //namespace HeadlessRenderer
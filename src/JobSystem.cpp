@@ -0,0 +1,146 @@
+#include <algorithm>
+
+#include "JobSystem.hpp"
+
+namespace JobSystem {
+
+namespace {
+
+void finishJob(Impl::JobState &state, std::exception_ptr error) {
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.finished = true;
+    state.error = std::move(error);
+    state.finishedCondition.notify_all();
+}
+
+} //namespace
+
+
+CancellationToken::CancellationToken(std::shared_ptr<Impl::JobState> state_) :
+    state{std::move(state_)} {}
+
+bool CancellationToken::isCancelled() const {
+    return state->cancelled.load(std::memory_order_relaxed);
+}
+
+void CancellationToken::setProgress(float progress) const {
+    state->progress.store(progress, std::memory_order_relaxed);
+}
+
+
+JobHandle::JobHandle(std::shared_ptr<Impl::JobState> state_) :
+    state{std::move(state_)} {}
+
+bool JobHandle::isValid() const {
+    return state != nullptr;
+}
+
+void JobHandle::cancel() {
+    if (state != nullptr) {
+        state->cancelled.store(true);
+    }
+}
+
+bool JobHandle::isCancelled() const {
+    return state != nullptr && state->cancelled.load();
+}
+
+bool JobHandle::isFinished() const {
+    if (state == nullptr) {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->finished;
+}
+
+void JobHandle::wait() const {
+    if (state == nullptr) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finishedCondition.wait(lock, [this]() {
+        return state->finished;
+    });
+}
+
+float JobHandle::progress() const {
+    return state == nullptr ? 0 : state->progress.load(std::memory_order_relaxed);
+}
+
+std::exception_ptr JobHandle::error() const {
+    if (state == nullptr) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(state->mutex);
+    return state->error;
+}
+
+
+WorkerPool::WorkerPool(size_t threadsNumber) :
+    stopping{false} {
+
+    for (size_t i = 0; i < threadsNumber; i++) {
+        workers.emplace_back(&WorkerPool::workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (auto &queue : jobs) {
+            for (auto &queuedJob : queue) {
+                queuedJob.state->cancelled.store(true);
+            }
+        }
+    }
+    jobsCondition.notify_all();
+
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+JobHandle WorkerPool::submit(Job job, Priority priority) {
+    auto state = std::make_shared<Impl::JobState>();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs[static_cast<size_t>(priority)].push_back({std::move(job), state});
+    }
+    jobsCondition.notify_one();
+
+    return JobHandle{state};
+}
+
+void WorkerPool::workerLoop() {
+    while (true) {
+        QueuedJob queuedJob;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobsCondition.wait(lock, [this]() {
+                return stopping || !jobs[0].empty() || !jobs[1].empty() || !jobs[2].empty();
+            });
+
+            auto queue = std::find_if(jobs.rbegin(), jobs.rend(), [](const auto &queue) {
+                return !queue.empty();
+            });
+            if (queue == jobs.rend()) {
+                return;
+            }
+            queuedJob = std::move(queue->front());
+            queue->pop_front();
+        }
+
+        std::exception_ptr error;
+        if (!queuedJob.state->cancelled.load()) {
+            try {
+                queuedJob.job(CancellationToken{queuedJob.state});
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+        finishJob(*queuedJob.state, std::move(error));
+    }
+}
+
+} //namespace JobSystem
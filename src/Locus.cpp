@@ -1,100 +1,677 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <QDebug>
+#include <QOpenGLContext>
+
 #include "Locus.hpp"
 
 namespace Locus {
 
-Locus::Locus(QVector<QVector3D> &&points) {
-    pointsBuffer = QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
-    pointsBuffer.create();
-    pointsBuffer.bind();
-    pointsBuffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
-    pointsBuffer.allocate(points.begin(), points.size() * 3 * sizeof(float));
-    pointsBuffer.release();
+using LocusLayout::LOD_LEVELS;
+using LocusLayout::LOD_LEVEL_SHIFT;
+using LocusLayout::getLevelSize;
+using LocusLayout::getLevelOffset;
+
+/* x, y and z normalised to the box of the block, padded to the size of an RGBA16 texel. */
+constexpr size_t PACKED_POINT_SIZE = 4 * sizeof(GLushort);
+
+/* GL keeps a flag per kind of error, so a few reads clear them, but a lost context reports
+   itself on every read. */
+constexpr int MAX_DRAINED_ERRORS = 8;
+
+void Locus::append(const float *points, size_t count, bool last) {
+    for (size_t i = 0; i < count; i++) {
+        QVector3D point(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+        if (!bounds.empty) {
+            pathLength += (point - lastPoint).length();
+        }
+        lastPoint = point;
+
+        size_t block = (getAppendedNumber() + i) / BLOCK_SIZE - firstBlock;
+        if (block >= blockBounds.size()) {
+            blockBounds.resize(block + 1);
+        }
+        blockBounds[block].extend(point);
+        bounds.extend(point);
+    }
+
+    LocusProgress::append(points, count, last);
 }
 
-void Locus::startWork() {
-    pointsBuffer.bind();
+float Locus::getStepLength() const {
+    size_t pointsNumber = getAppendedNumber();
+    return pointsNumber > 1 ? static_cast<float>(pathLength / (pointsNumber - 1)) : 0;
 }
 
-void Locus::endWork() {
-    pointsBuffer.release();
+QVector3D Locus::getCenter() const {
+    return (bounds.minimum + bounds.maximum) / 2;
 }
 
-size_t Locus::size() const {
-    return static_cast<size_t>(pointsBuffer.size() / 3 / sizeof(float));
+float Locus::getRadius() const {
+    return (bounds.maximum - bounds.minimum).length() / 2;
+}
+
+const Frustum::BoundingBox &Locus::getBounds() const {
+    return bounds;
+}
+
+/* A forgotten block gets an empty box, which no frustum intersects. */
+const Frustum::BoundingBox &Locus::getBlockBounds(size_t block) const {
+    static const Frustum::BoundingBox forgotten;
+    return block >= firstBlock ? blockBounds[block - firstBlock] : forgotten;
+}
+
+void Locus::forgetBlocksBefore(size_t block) {
+    while (firstBlock < block && !blockBounds.empty()) {
+        blockBounds.pop_front();
+        firstBlock++;
+    }
 }
 
 
 LocusController::LocusController() :
+    pointsBuffer{QOpenGLBuffer::VertexBuffer},
     prefs{&Preferences::defaultPreferences} {}
 
 void LocusController::setPreferences(const Preferences::Preferences *prefs_) {
     prefs = prefs_;
+    changed = true;
+}
+
+void LocusController::setFrameTimer(FrameTimer::FrameTimer *timer) {
+    frameTimer = timer;
+}
+
+bool LocusController::takeChanged() {
+    bool result = changed;
+    changed = false;
+    return result;
 }
 
 void LocusController::initialize() {
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+
     shaderController.initialize();
+    densityRenderer.initialize();
+    feedbackRenderer.initialize();
+    vertexArray.create();
+    splineVertexArray.create();
+
+    functions->glGenBuffers(1, &locusDataBuffer);
+    functions->glGenTextures(1, &locusDataTexture);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, locusDataTexture);
+    functions->glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32I, locusDataBuffer);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    functions->glGenBuffers(1, &blockBoundsBuffer);
+    functions->glGenTextures(1, &blockBoundsTexture);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, blockBoundsTexture);
+    functions->glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, blockBoundsBuffer);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    functions->glGenBuffers(1, &locusSizesBuffer);
+    functions->glGenTextures(1, &locusSizesTexture);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, locusSizesTexture);
+    functions->glTexBuffer(GL_TEXTURE_BUFFER, GL_R32I, locusSizesBuffer);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    functions->glGenTextures(1, &pointsTexture);
+    functions->glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTextureBufferSize);
 }
 
 size_t LocusController::size() const {
     return static_cast<size_t>(data.size());
 }
 
-void LocusController::addLocus(QVector<QVector3D> &&points_) {
-    shaderController.startWork();
-    data.push_back(Locus(std::move(points_)));
-    shaderController.endWork();
+size_t LocusController::getLevelsNumber() const {
+    return ringSize != 0 ? 1 : LOD_LEVELS;
+}
+
+void LocusController::setRingSize(size_t tailPointsNumber, size_t leadPointsNumber) {
+    changed = true;
+    feedbackRenderer.reset();
+    size_t pointsNumber = tailPointsNumber + leadPointsNumber;
+    ringSize = pointsNumber != 0 ? (pointsNumber / Locus::BLOCK_SIZE + 3) * Locus::BLOCK_SIZE : 0;
+    ringLead = ringSize != 0 ? leadPointsNumber : 0;
+}
+
+/* The newest ringLead points may already have overwritten the slots before the drawn time, and
+   the block being filled takes one more block. */
+size_t LocusController::getMaxTailPointsNumber(size_t tailPointsNumber) const {
+    return ringSize != 0 ? std::min(tailPointsNumber, ringSize - ringLead - Locus::BLOCK_SIZE) : tailPointsNumber;
+}
+
+size_t LocusController::selectLevel(const Locus &locus, const QMatrix4x4 &projMatrix, float viewportHeight) const {
+    /* The clip w of the nearest point of the bounding sphere; pixels per world unit scale with 1 / w. */
+    QVector4D depthRow = projMatrix.row(3);
+    float nearestDepth = QVector4D::dotProduct(depthRow, QVector4D(locus.getCenter(), 1)) -
+                         locus.getRadius() * depthRow.toVector3D().length();
+    if (nearestDepth <= 0) {
+        return 0;
+    }
+
+    float pixelsPerUnit = projMatrix.row(1).toVector3D().length() * viewportHeight / 2 / nearestDepth;
+    float gap = locus.getStepLength() * pixelsPerUnit;
+
+    size_t level = 0;
+    while (level + 1 < getLevelsNumber() &&
+           gap * (size_t{1} << ((level + 1) * LOD_LEVEL_SHIFT)) <= prefs->visualization.lodPixelError) {
+        level++;
+    }
+    return level;
+}
+
+void LocusController::addDrawRange(size_t regionOffset, size_t first, size_t last, bool vertexSmoothing,
+                                   GLint splineSegments) {
+    if (vertexSmoothing && last - first >= 2) {
+        drawFirsts.push_back(static_cast<GLint>((regionOffset + first) * splineSegments));
+        drawCounts.push_back(static_cast<GLsizei>((last - first - 1) * splineSegments + 1));
+    } else if (!vertexSmoothing && last != first) {
+        drawFirsts.push_back(static_cast<GLint>(regionOffset + first));
+        drawCounts.push_back(static_cast<GLsizei>(last - first));
+    }
+}
+
+/* Moves every locus into a region for the new capacity, keeping the points uploaded so far, and
+   adds empty loci up to locusNumber. Draw calls address vertices with GLint, so the buffer may not
+   hold more than INT_MAX points; past that, or when the driver is out of memory, nothing changes. */
+bool LocusController::reallocate(size_t locusNumber, size_t newCapacity) {
+    size_t newRegionSize = getLevelOffset(newCapacity, getLevelsNumber());
+    size_t pointsNumber = locusNumber * newRegionSize;
+    if (pointsNumber > static_cast<size_t>(std::numeric_limits<GLint>::max())) {
+        return false;
+    }
+
+    QOpenGLBuffer newBuffer(QOpenGLBuffer::VertexBuffer);
+    newBuffer.create();
+    newBuffer.bind();
+    /* Earlier errors would be taken for the one of the allocation. */
+    for (int i = 0; i < MAX_DRAINED_ERRORS && functions->glGetError() != GL_NO_ERROR; i++) {}
+    functions->glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(pointsNumber * PACKED_POINT_SIZE),
+                            nullptr, GL_STATIC_DRAW);
+    bool allocated = functions->glGetError() != GL_OUT_OF_MEMORY;
+    newBuffer.release();
+    if (!allocated) {
+        newBuffer.destroy();
+        return false;
+    }
+    data.resize(static_cast<int>(locusNumber));
+
+    if (pointsBuffer.isCreated()) {
+        functions->glBindBuffer(GL_COPY_READ_BUFFER, pointsBuffer.bufferId());
+        functions->glBindBuffer(GL_COPY_WRITE_BUFFER, newBuffer.bufferId());
+        for (size_t i = 0; i < static_cast<size_t>(data.size()); i++) {
+            for (size_t level = 0; level < getLevelsNumber() && data[i].size() != 0; level++) {
+                size_t copied = ringSize != 0 ? regionSize : getLevelSize(data[i].size(), level);
+                functions->glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER,
+                                               (i * regionSize + getLevelOffset(capacity, level)) * PACKED_POINT_SIZE,
+                                               (i * newRegionSize + getLevelOffset(newCapacity, level)) * PACKED_POINT_SIZE,
+                                               copied * PACKED_POINT_SIZE);
+            }
+        }
+        functions->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+        functions->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+    }
+
+    pointsBuffer = newBuffer;
+    capacity = newCapacity;
+    regionSize = newRegionSize;
+
+    vertexArray.bind();
+    pointsBuffer.bind();
+    shaderController.setVertex();
+    vertexArray.release();
+    pointsBuffer.release();
+
+    functions->glBindTexture(GL_TEXTURE_BUFFER, pointsTexture);
+    functions->glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA16, pointsBuffer.bufferId());
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    uploadLocusSizes();
+
+    /* The boxes of the new layout are rebuilt from the copies kept by every locus. */
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, blockBoundsBuffer);
+    functions->glBufferData(GL_TEXTURE_BUFFER,
+                            static_cast<GLsizeiptr>(data.size() * getBlocksPerRegion() * 8 * sizeof(GLfloat)),
+                            nullptr, GL_STATIC_DRAW);
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    size_t ringBlocks = ringSize / Locus::BLOCK_SIZE;
+    for (size_t i = 0; i < static_cast<size_t>(data.size()); i++) {
+        size_t blocks = (data[i].size() + Locus::BLOCK_SIZE - 1) / Locus::BLOCK_SIZE;
+        for (size_t block = blocks > ringBlocks && ringSize != 0 ? blocks - ringBlocks : 0; block < blocks; block++) {
+            uploadBlockBounds(i, block);
+        }
+    }
+    return true;
+}
+
+size_t LocusController::getBlocksPerRegion() const {
+    return (capacity + Locus::BLOCK_SIZE - 1) / Locus::BLOCK_SIZE;
+}
+
+/* Loci lagging behind the base show only the part of their tails after it. */
+GLint LocusController::getRelativeSize(const Locus &locus) const {
+    size_t size = locus.size() > sizesBase ? locus.size() - sizesBase : 0;
+    return static_cast<GLint>(std::min(size, static_cast<size_t>(std::numeric_limits<GLint>::max())));
+}
+
+void LocusController::uploadLocusSizes() {
+    std::vector<GLint> sizes;
+    for (const auto &locus : data) {
+        sizes.push_back(getRelativeSize(locus));
+    }
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, locusSizesBuffer);
+    functions->glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(sizes.size() * sizeof(GLint)),
+                            sizes.data(), GL_DYNAMIC_DRAW);
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LocusController::uploadBlockBounds(size_t locusIndex, size_t block) {
+    const Frustum::BoundingBox &box = data[static_cast<int>(locusIndex)].getBlockBounds(block);
+    QVector3D extent = box.maximum - box.minimum;
+    const GLfloat texels[8] = { box.minimum.x(), box.minimum.y(), box.minimum.z(), 0,
+                                extent.x(), extent.y(), extent.z(), 0 };
+
+    size_t ringBlocks = ringSize / Locus::BLOCK_SIZE;
+    size_t regionBlock = ringSize != 0 ? block % ringBlocks : block;
+
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, blockBoundsBuffer);
+    for (size_t copy = 0; copy < (ringSize != 0 ? 2 : 1); copy++) {
+        size_t index = locusIndex * getBlocksPerRegion() + regionBlock + copy * ringBlocks;
+        functions->glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(index * sizeof(texels)),
+                                   sizeof(texels), texels);
+    }
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, 0);
+}
+
+void LocusController::uploadBlock(size_t locusIndex, size_t count) {
+    auto &locus = data[static_cast<int>(locusIndex)];
+    const float *points = locus.getPendingPoints();
+    size_t first = locus.size();
+    size_t block = first / Locus::BLOCK_SIZE;
+
+    const Frustum::BoundingBox &box = locus.getBlockBounds(block);
+    const float minimum[3] = { box.minimum.x(), box.minimum.y(), box.minimum.z() };
+    const float extent[3] = { box.maximum.x() - minimum[0], box.maximum.y() - minimum[1],
+                              box.maximum.z() - minimum[2] };
+
+    auto writePoints = [this](size_t offset) {
+        functions->glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset * PACKED_POINT_SIZE),
+                                   static_cast<GLsizeiptr>(packedPoints.size() * sizeof(GLushort)), packedPoints.data());
+    };
+
+    /* Coarser levels take the points of the block whose indices are multiples of their step. */
+    pointsBuffer.bind();
+    for (size_t level = 0; level < getLevelsNumber(); level++) {
+        size_t shift = level * LOD_LEVEL_SHIFT;
+        size_t levelFirst = getLevelSize(first, level);
+        size_t levelLast = getLevelSize(first + count, level);
+        if (levelFirst == levelLast) {
+            continue;
+        }
+
+        packedPoints.resize(4 * (levelLast - levelFirst));
+        for (size_t i = levelFirst; i < levelLast; i++) {
+            const float *point = points + 3 * ((i << shift) - first);
+            GLushort *packed = packedPoints.data() + 4 * (i - levelFirst);
+            for (size_t axis = 0; axis < 3; axis++) {
+                float value = extent[axis] > 0 ? (point[axis] - minimum[axis]) / extent[axis] : 0;
+                packed[axis] = static_cast<GLushort>(std::lround(std::clamp(value, 0.0f, 1.0f) * 65535));
+            }
+            packed[3] = 0;
+        }
+        if (ringSize != 0) {
+            for (size_t slot : { levelFirst % ringSize, levelFirst % ringSize + ringSize }) {
+                writePoints(locusIndex * regionSize + slot);
+            }
+        } else {
+            writePoints(locusIndex * regionSize + getLevelOffset(capacity, level) + levelFirst);
+        }
+    }
+    pointsBuffer.release();
+
+    uploadBlockBounds(locusIndex, block);
+    locus.markUploaded(count);
+
+    const GLint uploadedNumber = getRelativeSize(locus);
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, locusSizesBuffer);
+    functions->glBufferSubData(GL_TEXTURE_BUFFER, static_cast<GLintptr>(locusIndex * sizeof(GLint)),
+                               sizeof(GLint), &uploadedNumber);
+    functions->glBindBuffer(GL_TEXTURE_BUFFER, 0);
+    changed |= first < drawnTime;
+
+    size_t ringBlocks = ringSize / Locus::BLOCK_SIZE;
+    if (ringSize != 0 && block >= ringBlocks) {
+        locus.forgetBlocksBefore(block + 1 - ringBlocks);
+    }
+}
+
+void LocusController::addChunk(const TrajectoryBuffer::TrajectoryChunk &chunk) {
+    size_t requiredCapacity = ringSize != 0 ? 2 * ringSize :
+                              std::max({capacity, chunk.buffer->capacity(), chunk.offset + chunk.count});
+    /* Empty trajectories need no room in the buffer, their loci only have to count as computed. */
+    if (requiredCapacity == 0) {
+        if (chunk.locusNumber > static_cast<size_t>(data.size())) {
+            data.resize(static_cast<int>(chunk.locusNumber));
+        }
+        if (chunk.locusIndex < static_cast<size_t>(data.size())) {
+            data[static_cast<int>(chunk.locusIndex)].append(nullptr, 0, chunk.last);
+        }
+        return;
+    }
+
+    /* Loci beyond the vertex limit of the buffer are left out. */
+    size_t maxLocusNumber = LocusLayout::getMaxLocusNumber(getLevelOffset(requiredCapacity, getLevelsNumber()),
+                                                           chunk.locusNumber,
+                                                           static_cast<size_t>(std::numeric_limits<GLint>::max()));
+    size_t locusNumber = std::max(static_cast<size_t>(data.size()), maxLocusNumber);
+    if ((locusNumber > static_cast<size_t>(data.size()) || requiredCapacity > capacity) &&
+        !reallocate(locusNumber, requiredCapacity)) {
+        refuseChunk(chunk);
+        return;
+    }
+    if (chunk.locusIndex >= static_cast<size_t>(data.size())) {
+        refuseChunk(chunk);
+        return;
+    }
+
+    /* Points after a refused chunk would not continue the ended locus. */
+    auto &locus = data[static_cast<int>(chunk.locusIndex)];
+    if (locus.isComplete()) {
+        return;
+    }
+    locus.append(chunk.buffer->data() + 3 * chunk.offset, chunk.count, chunk.last);
+
+    while (locus.getPendingNumber() >= Locus::BLOCK_SIZE || (chunk.last && locus.getPendingNumber() != 0)) {
+        uploadBlock(chunk.locusIndex, std::min(Locus::BLOCK_SIZE, locus.getPendingNumber()));
+    }
+}
+
+/* A locus that cannot grow ends at its uploaded points, so that it does not hold back the computed
+   frontier, and a locus that cannot be added is left out. */
+void LocusController::refuseChunk(const TrajectoryBuffer::TrajectoryChunk &chunk) {
+    if (!allocationFailed) {
+        qWarning() << "Not enough video memory for" << chunk.locusNumber << "loci of"
+                   << chunk.buffer->capacity() << "points, drawing only what fits";
+        allocationFailed = true;
+    }
+    if (chunk.locusIndex < static_cast<size_t>(data.size())) {
+        data[static_cast<int>(chunk.locusIndex)].finish();
+    }
+}
+
+size_t LocusController::computedPointsNumber() const {
+    if (data.empty()) {
+        return 0;
+    }
+
+    size_t frontier = std::numeric_limits<size_t>::max();
+    for (const auto &locus : data) {
+        if (!locus.isComplete()) {
+            frontier = std::min(frontier, locus.size());
+        }
+    }
+    return frontier;
 }
 
 void LocusController::clear() {
+    changed = true;
+    feedbackRenderer.reset();
     data.clear();
+    allocationFailed = false;
+    locusData.clear();
+    capacity = 0;
+    regionSize = 0;
+    ringSize = 0;
+    ringLead = 0;
+    sizesBase = 0;
+    pointsBuffer = QOpenGLBuffer(QOpenGLBuffer::VertexBuffer);
 }
 
-void LocusController::draw(const QMatrix4x4 &projMatrix, size_t time) {
+void LocusController::clearScreen() {
+    if (frameTimer != nullptr) {
+        frameTimer->begin(FrameStatistics::Section::Clear);
+    }
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    if (frameTimer != nullptr) {
+        frameTimer->end(FrameStatistics::Section::Clear);
+    }
+}
 
-    shaderController.startWork();
-    shaderController.setMatrix(projMatrix);
+void LocusController::draw(const QMatrix4x4 &projMatrix, size_t time) {
+    drawnTime = time;
+    size_t tailPointsNumber = prefs->visualization.tailPointsNumber;
+
+    /* A density portrait shows the whole trajectory up to the time, not only the tail. */
+    if (prefs->visualization.densityMode) {
+        feedbackRenderer.reset();
+        densityRenderer.startAccumulation();
+        drawTrajectories(projMatrix, time, time, true, prefs->visualization.tailColoringMode);
+        densityRenderer.resolve(prefs->visualization.densityExposure);
+        return;
+    }
+
+    /* Heads need the whole vertex buffer as a texture buffer, which the driver may not allow. */
+    if (prefs->visualization.instancedHeads && regionSize != 0 &&
+        static_cast<size_t>(data.size()) * regionSize <= static_cast<size_t>(maxTextureBufferSize)) {
+        feedbackRenderer.reset();
+        clearScreen();
+        drawHeads(projMatrix, time);
+        return;
+    }
+
+    /* The carried trails hold every segment up to the previous time, and fading draws the tail.
+       A few points before it are drawn again, since strips with adjacency leave out their first
+       and last segments. Colors go by trajectory, as the drawn part is no longer the whole tail. */
+    if (prefs->visualization.feedbackTrails) {
+        if (time < feedbackTime) {
+            feedbackRenderer.reset();
+        }
+        bool carried = feedbackRenderer.startFrame(projMatrix, prefs->visualization.trailFade);
+        size_t newPointsNumber = carried ? time - feedbackTime + FEEDBACK_OVERLAP : tailPointsNumber;
+        drawTrajectories(projMatrix, time, std::min(newPointsNumber, tailPointsNumber), false, false);
+        feedbackRenderer.finishFrame();
+        feedbackTime = time;
+        return;
+    }
+
+    feedbackRenderer.reset();
+    clearScreen();
+    drawTrajectories(projMatrix, time, tailPointsNumber, false, prefs->visualization.tailColoringMode);
+}
+
+/* Costs the same on the CPU however many loci there are: no culling, no levels of detail and
+   no per-locus data beyond the sizes kept up to date by uploads. */
+void LocusController::drawHeads(const QMatrix4x4 &projMatrix, size_t time) {
+    size_t tailPointsNumber = getMaxTailPointsNumber(prefs->visualization.tailPointsNumber);
+    if (tailPointsNumber == 0) {
+        return;
+    }
 
-    shaderController.setArcadeMode(prefs->visualization.arcadeMode);
+    shaderController.setProgram(ShaderController::ShaderController::getProgramHandle(
+        ShaderController::ShaderController::Technique::InstancedHeads, prefs->visualization.primitive,
+        prefs->visualization.arcadeMode, prefs->visualization.tailColoringMode, false));
 
-    shaderController.setTailColoringMode(prefs->visualization.tailColoringMode);
+    shaderController.setMatrix(projMatrix);
     shaderController.setTrajectoriesNumber(static_cast<size_t>(data.size()));
     shaderController.setColors(prefs->visualization.colors);
+    shaderController.setStartTailSize(prefs->visualization.startPointSize);
+    shaderController.setFinalTailSize(prefs->visualization.finalPointSize);
+    shaderController.setRegionSize(regionSize);
+    shaderController.setBlockLayout(Locus::BLOCK_SIZE, getBlocksPerRegion());
+    /* The drawn points are the same modulo ringSize counted from any multiple of it, so the
+       time and the sizes stay small however long live mode runs. */
+    size_t start = time > tailPointsNumber ? time - tailPointsNumber : 0;
+    size_t base = ringSize != 0 ? start - start % ringSize : 0;
+    if (base != sizesBase) {
+        sizesBase = base;
+        uploadLocusSizes();
+    }
+    shaderController.setCurrentTime(time - base);
+    shaderController.setTailPointsNumber(tailPointsNumber);
+    shaderController.setRingSize(ringSize);
 
-    shaderController.setInterpolationDistance(prefs->visualization.interpolationDistance);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::LOCUS_SIZES_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, locusSizesTexture);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::BLOCK_BOUNDS_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, blockBoundsTexture);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::POINTS_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, pointsTexture);
+
+    shaderController.startWork();
+
+    splineVertexArray.bind();
+    functions->glDrawArraysInstanced(GL_POINTS, 0, static_cast<GLsizei>(tailPointsNumber),
+                                     static_cast<GLsizei>(data.size()));
+    splineVertexArray.release();
+
+    shaderController.endWork();
+
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::BLOCK_BOUNDS_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::LOCUS_SIZES_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::LOCUS_DATA_TEXTURE_UNIT);
+}
+
+void LocusController::drawTrajectories(const QMatrix4x4 &projMatrix, size_t time, size_t tailPointsNumber,
+                                       bool densityMode, bool tailColoringMode) {
+    /* Loci of empty trajectories alone have no buffer to draw from. */
+    if (regionSize == 0) {
+        return;
+    }
+
+    tailPointsNumber = getMaxTailPointsNumber(tailPointsNumber);
+    size_t start = time > tailPointsNumber ? time - tailPointsNumber : 0;
+
+    /* In live mode a window starting at start sits in the ring from start % ringSize on. */
+    size_t base = ringSize != 0 ? start - start % ringSize : 0;
+
+    /* Spline expansion in the vertex shader reads every point through the texture buffer,
+       whose size the driver may limit below the size of the scene, and numbers the expanded
+       vertices with gl_VertexID, which has to stay within an int. */
+    size_t scenePoints = static_cast<size_t>(data.size()) * regionSize;
+    size_t requestedSegments = static_cast<size_t>(std::max(1, prefs->visualization.splineSegments));
+    bool vertexSmoothing = !densityMode && prefs->visualization.vertexSmoothing &&
+                           scenePoints <= static_cast<size_t>(maxTextureBufferSize) &&
+                           scenePoints * requestedSegments <= static_cast<size_t>(std::numeric_limits<GLint>::max());
+    GLint splineSegments = vertexSmoothing ? static_cast<GLint>(requestedSegments) : 1;
 
-    shaderController.setPrimitive(prefs->visualization.primitive);
+    if (locusData.size() != 4 * static_cast<size_t>(data.size())) {
+        locusData.resize(4 * static_cast<size_t>(data.size()));
+        locusDataChanged = true;
+    }
+    GLint viewport[4];
+    functions->glGetIntegerv(GL_VIEWPORT, viewport);
+
+    Frustum::Frustum frustum(projMatrix);
 
+    drawFirsts.clear();
+    drawCounts.clear();
     for (size_t i = 0; i < static_cast<size_t>(data.size()); i++) {
-        auto &locus = data[i];
+        size_t end = std::min(time, data[i].size());
 
-        locus.startWork();
+        /* The tail keeps its time window on every level, it just holds fewer points on coarser ones. */
+        size_t level = selectLevel(data[i], projMatrix, static_cast<float>(viewport[3]));
+        size_t levelStart = getLevelSize(start, level);
+        size_t levelEnd = end > start ? ((end - 1) >> (level * LOD_LEVEL_SHIFT)) + 1 : levelStart;
+        size_t actualLength = levelEnd > levelStart ? levelEnd - levelStart : 0;
+        size_t levelOffset = getLevelOffset(capacity, level);
+        size_t tailStart = levelOffset + levelStart - base;
 
-        if (locus.size() == 0) {
+        const GLint tail[4] = { static_cast<GLint>(tailStart), static_cast<GLint>(actualLength),
+                                static_cast<GLint>(level * LOD_LEVEL_SHIFT), static_cast<GLint>(levelOffset) };
+        if (!std::equal(tail, tail + 4, locusData.begin() + 4 * i)) {
+            std::copy_n(tail, 4, locusData.begin() + 4 * i);
+            locusDataChanged = true;
+        }
+        if (actualLength == 0 || !frustum.intersects(data[i].getBounds())) {
             continue;
         }
 
-        size_t start = std::max(0, static_cast<int>(time) - static_cast<int>(prefs->visualization.tailPointsNumber));
-        if (start >= locus.size()) {
-            locus.endWork();
+        /* Runs of visible blocks become separate draws. A run reaches into its neighbours, so that
+           the segments crossing block borders are drawn, which with adjacency takes one more point.
+           Density splats have no segments, and must not count any point twice. */
+        size_t margin = densityMode ? 0 : vertexSmoothing ? 1 : 2;
+        size_t runFirst = levelEnd;
+        for (size_t block = start / Locus::BLOCK_SIZE; block <= (end - 1) / Locus::BLOCK_SIZE; block++) {
+            size_t blockFirst = std::max(levelStart, getLevelSize(block * Locus::BLOCK_SIZE, level));
+            size_t blockLast = std::min(levelEnd, getLevelSize((block + 1) * Locus::BLOCK_SIZE, level));
+            bool visible = blockFirst < blockLast && frustum.intersects(data[i].getBlockBounds(block));
 
-            continue;
+            if (visible && runFirst == levelEnd) {
+                runFirst = blockFirst;
+            } else if (!visible && runFirst != levelEnd) {
+                addDrawRange(i * regionSize + levelOffset, std::max(levelStart + margin, runFirst) - margin - base,
+                             std::min(levelEnd, blockFirst + margin) - base, vertexSmoothing, splineSegments);
+                runFirst = levelEnd;
+            }
+        }
+        if (runFirst != levelEnd) {
+            addDrawRange(i * regionSize + levelOffset, std::max(levelStart + margin, runFirst) - margin - base,
+                         levelEnd - base, vertexSmoothing, splineSegments);
         }
-        size_t actualLength = std::min(time, locus.size()) - start;
+    }
+    if (drawFirsts.empty()) {
+        return;
+    }
 
-        shaderController.setVertex();
+    if (locusDataChanged) {
+        functions->glBindBuffer(GL_TEXTURE_BUFFER, locusDataBuffer);
+        functions->glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(locusData.size() * sizeof(GLint)),
+                                locusData.data(), GL_STREAM_DRAW);
+        functions->glBindBuffer(GL_TEXTURE_BUFFER, 0);
+        locusDataChanged = false;
+    }
 
-        shaderController.setStartTailSize(prefs->visualization.startPointSize);
-        shaderController.setFinalTailSize(prefs->visualization.finalPointSize);
-        shaderController.setTailLength(actualLength);
-        shaderController.setStartVertexIndex(start);
-        shaderController.setTrajectoryIndex(i);
+    using Technique = ShaderController::ShaderController::Technique;
+    shaderController.setProgram(ShaderController::ShaderController::getProgramHandle(
+        densityMode ? Technique::Density : Technique::Tails, prefs->visualization.primitive,
+        prefs->visualization.arcadeMode, tailColoringMode, vertexSmoothing));
 
-        glDrawArrays(GL_LINE_STRIP_ADJACENCY, start, actualLength);
+    /* The setters only touch the CPU copy of the frame state, which startWork uploads when it changed. */
+    shaderController.setMatrix(projMatrix);
 
-        locus.endWork();
+    shaderController.setTrajectoriesNumber(static_cast<size_t>(data.size()));
+    shaderController.setColors(prefs->visualization.colors);
+
+    shaderController.setInterpolationDistance(prefs->visualization.interpolationDistance);
+    shaderController.setSplineSegments(splineSegments);
+
+    shaderController.setStartTailSize(prefs->visualization.startPointSize);
+    shaderController.setFinalTailSize(prefs->visualization.finalPointSize);
+    shaderController.setRegionSize(regionSize);
+    shaderController.setBlockLayout(Locus::BLOCK_SIZE, getBlocksPerRegion());
+
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::LOCUS_DATA_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, locusDataTexture);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::BLOCK_BOUNDS_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, blockBoundsTexture);
+    if (vertexSmoothing) {
+        functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::POINTS_TEXTURE_UNIT);
+        functions->glBindTexture(GL_TEXTURE_BUFFER, pointsTexture);
     }
+
+    shaderController.startWork();
+
+    GLenum mode = densityMode ? GL_POINTS : vertexSmoothing ? prefs->visualization.primitive : GL_LINE_STRIP_ADJACENCY;
+    QOpenGLVertexArrayObject &drawVertexArray = vertexSmoothing ? splineVertexArray : vertexArray;
+    drawVertexArray.bind();
+    functions->glMultiDrawArrays(mode, drawFirsts.data(), drawCounts.data(), static_cast<GLsizei>(drawFirsts.size()));
+    drawVertexArray.release();
+
     shaderController.endWork();
+
+    if (vertexSmoothing) {
+        functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+        functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::BLOCK_BOUNDS_TEXTURE_UNIT);
+    }
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
+    functions->glActiveTexture(GL_TEXTURE0 + ShaderController::ShaderController::LOCUS_DATA_TEXTURE_UNIT);
+    functions->glBindTexture(GL_TEXTURE_BUFFER, 0);
 }
 
 } //namespace Locus
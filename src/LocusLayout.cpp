@@ -0,0 +1,23 @@
+#include <algorithm>
+
+#include "LocusLayout.hpp"
+
+namespace LocusLayout {
+
+size_t getLevelSize(size_t pointsNumber, size_t level) {
+    return (pointsNumber + (size_t{1} << (level * LOD_LEVEL_SHIFT)) - 1) >> (level * LOD_LEVEL_SHIFT);
+}
+
+size_t getLevelOffset(size_t pointsCapacity, size_t level) {
+    size_t offset = 0;
+    for (size_t i = 0; i < level; i++) {
+        offset += getLevelSize(pointsCapacity, i);
+    }
+    return offset;
+}
+
+size_t getMaxLocusNumber(size_t regionSize, size_t locusNumber, size_t maxPointsNumber) {
+    return regionSize != 0 ? std::min(locusNumber, maxPointsNumber / regionSize) : locusNumber;
+}
+
+} //namespace LocusLayout
@@ -0,0 +1,45 @@
+#include "LocusProgress.hpp"
+
+namespace LocusProgress {
+
+size_t LocusProgress::size() const {
+    return uploadedNumber;
+}
+
+size_t LocusProgress::getAppendedNumber() const {
+    return pointsNumber;
+}
+
+bool LocusProgress::isComplete() const {
+    return complete && uploadedNumber == pointsNumber;
+}
+
+const float *LocusProgress::getPendingPoints() const {
+    return pendingPoints.data() + pendingStart;
+}
+
+size_t LocusProgress::getPendingNumber() const {
+    return pointsNumber - uploadedNumber;
+}
+
+void LocusProgress::markUploaded(size_t count) {
+    pendingStart += 3 * count;
+    uploadedNumber += count;
+}
+
+void LocusProgress::append(const float *points, size_t count, bool last) {
+    pendingPoints.erase(pendingPoints.begin(), pendingPoints.begin() + pendingStart);
+    pendingStart = 0;
+    pendingPoints.insert(pendingPoints.end(), points, points + 3 * count);
+    pointsNumber += count;
+    complete = last;
+}
+
+void LocusProgress::finish() {
+    pendingPoints.clear();
+    pendingStart = 0;
+    pointsNumber = uploadedNumber;
+    complete = true;
+}
+
+} //namespace LocusProgress
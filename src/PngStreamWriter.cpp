@@ -0,0 +1,96 @@
+#include <csetjmp>
+#include <stdexcept>
+
+#include "PngStreamWriter.hpp"
+
+namespace PngStreamWriter {
+
+PngStreamWriter::~PngStreamWriter() {
+    destroy();
+}
+
+bool PngStreamWriter::isOpen() const {
+    return png != nullptr;
+}
+
+void PngStreamWriter::destroy() {
+    if (png != nullptr) {
+        png_destroy_write_struct(&png, &info);
+        png = nullptr;
+        info = nullptr;
+    }
+    if (file != nullptr) {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+void PngStreamWriter::open(const std::string &filename, uint32_t imageWidth, uint32_t imageHeight) {
+    destroy();
+    width = imageWidth;
+    height = imageHeight;
+    writtenRows = 0;
+
+    file = std::fopen(filename.c_str(), "wb");
+    if (file == nullptr) {
+        throw std::runtime_error("Could not create " + filename + ".");
+    }
+    png = png_create_write_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
+    info = png == nullptr ? nullptr : png_create_info_struct(png);
+    if (info == nullptr || !writeHeader()) {
+        destroy();
+        throw std::runtime_error("Could not start writing " + filename + ".");
+    }
+}
+
+bool PngStreamWriter::writeHeader() {
+    if (setjmp(png_jmpbuf(png))) {
+        return false;
+    }
+    png_init_io(png, file);
+    png_set_IHDR(png, info, width, height, 8, PNG_COLOR_TYPE_RGB, PNG_INTERLACE_NONE,
+                 PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+    png_write_info(png, info);
+    return true;
+}
+
+void PngStreamWriter::writeRow(const uint8_t *row) {
+    if (!isOpen() || writtenRows == height) {
+        throw std::logic_error("No more rows to write.");
+    }
+    if (!writePngRow(row)) {
+        destroy();
+        throw std::runtime_error("Could not write a row of the image.");
+    }
+    writtenRows++;
+}
+
+bool PngStreamWriter::writePngRow(const uint8_t *row) {
+    if (setjmp(png_jmpbuf(png))) {
+        return false;
+    }
+    png_write_row(png, row);
+    return true;
+}
+
+void PngStreamWriter::close() {
+    if (!isOpen() || writtenRows != height) {
+        destroy();
+        throw std::logic_error("The image is not complete.");
+    }
+    bool written = writeEnd();
+    destroy();
+    if (!written) {
+        throw std::runtime_error("Could not finish writing the image.");
+    }
+}
+
+bool PngStreamWriter::writeEnd() {
+    if (setjmp(png_jmpbuf(png))) {
+        return false;
+    }
+    png_write_end(png, nullptr);
+    return true;
+}
+
+} //namespace PngStreamWriter
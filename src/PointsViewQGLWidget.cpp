@@ -1,18 +1,70 @@
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include <QApplication>
+#include <QDebug>
 #include <QFileInfo>
+#include <fstream>
 
 #include "PointsViewQGLWidget.hpp"
 
 PointsViewQGLWidget::PointsViewQGLWidget(QWidget *parent) :
-    QGLWidget{QGLFormat(), parent},
-    prefs{&Preferences::defaultPreferences} {}
+    QGLWidget{getFormat(), parent},
+    prefs{&Preferences::defaultPreferences},
+    currentTime{0},
+    computedPoints{0},
+    requestedClears{0},
+    finishedClears{0},
+    viewportWidth{0},
+    viewportHeight{0},
+    screenshotRequested{false},
+    redrawRequested{true},
+    frameStatistics{SESSION_FRAMES},
+    qualityGovernor{1000.0 / Preferences::defaultPreferences.controller.targetFrameRate},
+    sliderMilliseconds{-1} {
+
+    setAutoBufferSwap(false);
+    locusController.setPreferences(&governedPreferences);
+    cameraController.setPreferences(&renderPreferences);
+    locusController.setFrameTimer(&frameTimer);
+
+    /* The context goes back to the GUI thread at the end, where the GL objects are destroyed. */
+    renderThread.setCallbacks([this] {
+        makeCurrent();
+        initializeGL();
+        lastFrameTime = sessionStart = std::chrono::steady_clock::now();
+    }, [this] {
+        return renderFrame();
+    }, [this] {
+        doneCurrent();
+        context()->moveToThread(QApplication::instance()->thread());
+    });
+}
+
+PointsViewQGLWidget::~PointsViewQGLWidget() {
+    renderThread.stop();
+    makeCurrent();
+}
+
+/* Swapping buffers waits for vsync, which paces the render thread. */
+QGLFormat PointsViewQGLWidget::getFormat() {
+    QGLFormat format;
+    format.setSwapInterval(1);
+    return format;
+}
 
 void PointsViewQGLWidget::setPreferences(const Preferences::Preferences *prefs_) {
     prefs = prefs_;
-    locusController.setPreferences(prefs);
-    cameraController.setPreferences(prefs);
+    renderThread.setTargetFrameRate(prefs->controller.targetFrameRate);
+    renderThread.post([this, copy = *prefs] {
+        renderPreferences = copy;
+        qualityGovernor.setTarget(1000.0 / std::max(1, copy.controller.targetFrameRate));
+        if (!copy.visualization.adaptiveQuality) {
+            qualityGovernor.reset();
+        }
+        updateGovernedPreferences();
+        redrawRequested = true;
+    });
 }
 
 QSize PointsViewQGLWidget::minimumSizeHint() const {
@@ -23,35 +75,70 @@ QSize PointsViewQGLWidget::sizeHint() const {
     return { 1080, 720 };
 }
 
-void PointsViewQGLWidget::addNewLocus(QVector<QVector3D> &&points) {
-    locusController.addLocus(std::move(points));
+void PointsViewQGLWidget::addChunk(const TrajectoryBuffer::TrajectoryChunk &chunk) {
+    renderThread.post([this, chunk] {
+        locusController.addChunk(chunk);
+    });
 }
 
-void PointsViewQGLWidget::setCurrentTime(const int currentTime_) {
-    currentTime = currentTime_;
+size_t PointsViewQGLWidget::computedPointsNumber() const {
+    if (finishedClears.load() != requestedClears.load()) {
+        return 0;
+    }
+    return computedPoints.load();
 }
 
-bool PointsViewQGLWidget::startVideoRecording(const QString &filename) {
-    try {
-        videoEncoder.startEncoding(prefs->video.width, prefs->video.height, filename.toStdString().c_str());
+void PointsViewQGLWidget::setCurrentTime(const size_t currentTime_) {
+    if (currentTime.exchange(currentTime_) != currentTime_) {
+        renderThread.wake();
+    }
+}
 
-        return true;
-    } catch (const std::exception &e) {
-        videoEncoder.endEncoding();
+void PointsViewQGLWidget::setSliderTime(double milliseconds) {
+    sliderMilliseconds = milliseconds;
+}
 
-        return false;
-    }
+void PointsViewQGLWidget::requestRedraw() {
+    redrawRequested = true;
+    renderThread.wake();
+}
+
+void PointsViewQGLWidget::setRingSize(size_t tailPointsNumber, size_t leadPointsNumber) {
+    renderThread.post([this, tailPointsNumber, leadPointsNumber] {
+        locusController.setRingSize(tailPointsNumber, leadPointsNumber);
+    });
+}
+
+bool PointsViewQGLWidget::startVideoRecording(const QString &filename) {
+    bool started = false;
+    renderThread.invoke([this, &started, width = prefs->video.width, height = prefs->video.height,
+                         name = filename.toStdString()] {
+        try {
+            videoEncoder.startEncoding(width, height, name.c_str());
+            started = true;
+        } catch (const std::exception &e) {
+            videoEncoder.endEncoding();
+        }
+    });
+    return started;
 }
 
 void PointsViewQGLWidget::endVideoRecording(std::function<void (int)> callback) {
-    auto drawFunc = [&lc = locusController](const QMatrix4x4 &projMatrix, size_t time) {
-        lc.draw(projMatrix, time);
-    };
-    videoEncoder.endEncoding(std::move(drawFunc), std::move(callback));
+    renderThread.invoke([this, &callback] {
+        auto drawFunc = [&lc = locusController](const QMatrix4x4 &projMatrix, size_t time) {
+            lc.draw(projMatrix, time);
+        };
+        videoEncoder.endEncoding(std::move(drawFunc), std::move(callback));
+        redrawRequested = true;
+    });
 }
 
 void PointsViewQGLWidget::clearAll() {
-    locusController.clear();
+    renderThread.post([this, clear = ++requestedClears] {
+        locusController.clear();
+        computedPoints = 0;
+        finishedClears = clear;
+    });
 }
 
 void PointsViewQGLWidget::initializeGL() {
@@ -63,6 +150,9 @@ void PointsViewQGLWidget::initializeGL() {
     qglClearColor(QColor(Qt::black));
 
     locusController.initialize();
+    frameTimer.initialize();
+    statisticsOverlay.initialize();
+    tiledRenderer.initialize();
 }
 
 void PointsViewQGLWidget::resizeGL(int width, int height) {
@@ -70,40 +160,238 @@ void PointsViewQGLWidget::resizeGL(int width, int height) {
 }
 
 void PointsViewQGLWidget::paintGL() {
-    locusController.draw(cameraController.getMatrix(), currentTime);
+    locusController.draw(renderedMatrix, renderedTime);
 
     if (videoEncoder.isWorking()) {
         videoEncoder.writeState({cameraController.getPosition(),
                                  cameraController.getTarget(),
-                                 currentTime});
+                                 renderedTime});
+    }
+}
+
+/* The camera moves by the wall clock time since the previous frame, whatever the frame rate is,
+   but a frame after a pause does not make up for the time the thread slept. */
+bool PointsViewQGLWidget::renderFrame() {
+    constexpr static float MAX_FRAME_MILLISECONDS = 100;
+
+    bool changed = redrawRequested.exchange(false) || videoEncoder.isWorking();
+
+    int width = viewportWidth.load();
+    int height = viewportHeight.load();
+    if ((width != renderedWidth || height != renderedHeight) && width > 0 && height > 0) {
+        resizeGL(renderedWidth = width, renderedHeight = height);
+        changed = true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    frameTimer.startFrame(std::chrono::duration<double, std::milli>(now - sessionStart).count());
+
+    float elapsed = std::chrono::duration<float, std::milli>(now - lastFrameTime).count();
+    frameTimer.begin(FrameStatistics::Section::Camera);
+    cameraController.update(std::min(elapsed, MAX_FRAME_MILLISECONDS));
+    frameTimer.end(FrameStatistics::Section::Camera);
+    lastFrameTime = now;
+
+    computedPoints = locusController.computedPointsNumber();
+
+    QMatrix4x4 matrix = cameraController.getMatrix();
+    size_t time = currentTime.load();
+    changed |= locusController.takeChanged();
+    if (!changed && matrix == renderedMatrix && time == renderedTime) {
+        frameTimer.cancelFrame();
+        return false;
+    }
+    renderedMatrix = matrix;
+    renderedTime = time;
+    frameTimer.setCpuTime(FrameStatistics::Section::Slider, sliderMilliseconds.exchange(-1));
+
+    frameTimer.begin(FrameStatistics::Section::Draw);
+    paintGL();
+    frameTimer.end(FrameStatistics::Section::Draw);
+    if (screenshotRequested.exchange(false)) {
+        frameTimer.begin(FrameStatistics::Section::Readback);
+        saveScreenshot();
+        frameTimer.end(FrameStatistics::Section::Readback);
+    }
+    governQuality(frameTimer.finishFrame(frameStatistics));
+
+    /* After the screenshot, which should not show the overlay. */
+    drawStatisticsOverlay();
+    swapBuffers();
+    return true;
+}
+
+/* A frame takes as long as the slower of the CPU and the GPU. Every turned knob is logged. */
+void PointsViewQGLWidget::governQuality(size_t framesNumber) {
+    if (!renderPreferences.visualization.adaptiveQuality) {
+        return;
+    }
+
+    bool adjusted = false;
+    for (size_t i = frameStatistics.size() - framesNumber; i < frameStatistics.size(); i++) {
+        auto frameIndex = static_cast<size_t>(FrameStatistics::Section::Frame);
+        auto adjustment = qualityGovernor.addFrame(std::max(frameStatistics[i].cpu[frameIndex],
+                                                            frameStatistics[i].gpu[frameIndex]));
+        if (adjustment) {
+            qInfo() << "Quality governor" << (adjustment->lowered ? "lowered" : "raised")
+                    << QualityGovernor::getKnobName(adjustment->knob) << "to level" << -static_cast<int>(adjustment->level);
+            adjusted = true;
+        }
+    }
+    if (adjusted) {
+        updateGovernedPreferences();
+    }
+}
+
+void PointsViewQGLWidget::updateGovernedPreferences() {
+    governedPreferences = renderPreferences;
+    auto &visualization = governedPreferences.visualization;
+    auto settings = qualityGovernor.apply({visualization.splineSegments, visualization.interpolationDistance,
+                                           visualization.lodPixelError, visualization.tailPointsNumber});
+    visualization.splineSegments = settings.splineSegments;
+    visualization.interpolationDistance = settings.interpolationDistance;
+    visualization.lodPixelError = settings.lodPixelError;
+    visualization.tailPointsNumber = settings.tailPointsNumber;
+    locusController.setPreferences(&governedPreferences);
+}
+
+void PointsViewQGLWidget::drawStatisticsOverlay() {
+    if (!renderPreferences.visualization.statisticsOverlay) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (now - overlayUpdateTime >= std::chrono::milliseconds(OVERLAY_UPDATE_MILLISECONDS)) {
+        QString status;
+        if (renderPreferences.visualization.adaptiveQuality) {
+            status = QString::fromStdString("quality: " + qualityGovernor.describe());
+        }
+        statisticsOverlay.update(frameStatistics.getMean(OVERLAY_MEAN_FRAMES), status);
+        overlayUpdateTime = now;
+    }
+    statisticsOverlay.draw();
+}
+
+void PointsViewQGLWidget::saveScreenshot() {
+    static auto getFileName = [](size_t number) {
+        return QString::fromStdString("screenshot_" + std::to_string(number) + ".png");
+    };
+
+    static size_t screenshotNumber = 0;
+    while (QFileInfo(getFileName(screenshotNumber)).exists()) {
+        screenshotNumber++;
+    }
+
+    grabFrameBuffer().save(getFileName(screenshotNumber), "PNG");
+}
+
+/* Writes the frames of the session both as CSV and as JSON, numbered like the screenshots. */
+void PointsViewQGLWidget::saveStatistics() {
+    static auto getFileName = [](size_t number, const std::string &extension) {
+        return "frame_statistics_" + std::to_string(number) + extension;
+    };
+
+    static size_t statisticsNumber = 0;
+    while (QFileInfo(QString::fromStdString(getFileName(statisticsNumber, ".csv"))).exists()) {
+        statisticsNumber++;
+    }
+
+    std::ofstream csv(getFileName(statisticsNumber, ".csv"));
+    frameStatistics.writeCsv(csv);
+    std::ofstream json(getFileName(statisticsNumber, ".json"));
+    frameStatistics.writeJson(json);
+}
+
+/* Posters show the requested quality whatever the governor has lowered, and without feedback
+   trails, which would carry one tile over into the next. */
+void PointsViewQGLWidget::savePoster() {
+    static auto getFileName = [](size_t number) {
+        return "poster_" + std::to_string(number) + ".png";
+    };
+
+    static size_t posterNumber = 0;
+    while (QFileInfo(QString::fromStdString(getFileName(posterNumber))).exists()) {
+        posterNumber++;
+    }
+
+    int width = renderPreferences.video.posterWidth;
+    int height = renderPreferences.video.posterHeight;
+    cameraController.recalculatePerspective(width, height);
+    QMatrix4x4 matrix = cameraController.getMatrix();
+    cameraController.recalculatePerspective(renderedWidth, renderedHeight);
+
+    Preferences::Preferences posterPreferences = renderPreferences;
+    posterPreferences.visualization.feedbackTrails = false;
+    locusController.setPreferences(&posterPreferences);
+    try {
+        tiledRenderer.render(matrix, width, height, getFileName(posterNumber), [this](const QMatrix4x4 &tileMatrix) {
+            locusController.draw(tileMatrix, renderedTime);
+        });
+    } catch (const std::exception &e) {
+        qWarning() << "Could not save the poster:" << e.what();
+    }
+    locusController.setPreferences(&governedPreferences);
+    redrawRequested = true;
+}
+
+/* The frame itself is drawn by the render thread. */
+void PointsViewQGLWidget::paintEvent(QPaintEvent *) {
+    requestRedraw();
+}
+
+void PointsViewQGLWidget::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    viewportWidth = static_cast<int>(event->size().width() * devicePixelRatioF());
+    viewportHeight = static_cast<int>(event->size().height() * devicePixelRatioF());
+    renderThread.wake();
+}
+
+void PointsViewQGLWidget::showEvent(QShowEvent *event) {
+    QGLWidget::showEvent(event);
+
+    if (!renderThread.isRunning() && !renderThread.isFinished()) {
+        doneCurrent();
+        context()->moveToThread(&renderThread);
+        renderThread.start();
     }
 }
 
 void PointsViewQGLWidget::mouseMoveEvent(QMouseEvent *event) {
-    cameraController.applyMouseMoveEvent(event);
+    renderThread.post([this, position = event->pos()] {
+        cameraController.applyMouseMove(position);
+    });
+    event->accept();
 }
 
 void PointsViewQGLWidget::mousePressEvent(QMouseEvent *event) {
-    cameraController.applyMousePressEvent(event);
+    renderThread.post([this, position = event->pos()] {
+        cameraController.applyMousePress(position);
+    });
+    event->accept();
 }
 
 void PointsViewQGLWidget::keyPressEvent(QKeyEvent *event) {
-    cameraController.applyKeyPressEvent(event);
+    renderThread.post([this, key = event->key()] {
+        cameraController.applyKeyPress(key);
+    });
+    event->accept();
 
     if (event->key() == Qt::Key_R) {
-        static auto getFileName = [](size_t number) {
-            return QString::fromStdString("screenshot_" + std::to_string(number) + ".png");
-        };
-
-        static size_t screenshotNumber = 0;
-        while (QFileInfo(getFileName(screenshotNumber)).exists()) {
-            screenshotNumber++;
-        }
-
-        grabFrameBuffer().save(getFileName(screenshotNumber), "PNG");
+        screenshotRequested = true;
+        requestRedraw();
+    } else if (event->key() == Qt::Key_P) {
+        renderThread.post([this] {
+            savePoster();
+        });
+    } else if (event->key() == Qt::Key_T) {
+        renderThread.post([this] {
+            saveStatistics();
+        });
     }
 }
 
 void PointsViewQGLWidget::keyReleaseEvent(QKeyEvent *event) {
-    cameraController.applyKeyReleaseEvent(event);
+    renderThread.post([this, key = event->key()] {
+        cameraController.applyKeyRelease(key);
+    });
+    event->accept();
 }
@@ -0,0 +1,112 @@
+#include <algorithm>
+
+#include "QualityGovernor.hpp"
+
+namespace QualityGovernor {
+
+const char *getKnobName(Knob knob) {
+    switch (knob) {
+    case Knob::Subdivision:
+        return "subdivision";
+    case Knob::LevelOfDetail:
+        return "level of detail";
+    case Knob::PointBudget:
+        return "point budget";
+    default:
+        return "";
+    }
+}
+
+QualityGovernor::QualityGovernor(double targetMilliseconds) : target{targetMilliseconds} {}
+
+void QualityGovernor::setTarget(double targetMilliseconds) {
+    if (targetMilliseconds != target) {
+        target = targetMilliseconds;
+        restart();
+    }
+}
+
+void QualityGovernor::reset() {
+    levels.fill(0);
+    restart();
+}
+
+void QualityGovernor::restart() {
+    smoothedTime = 0;
+    measuredFrames = 0;
+    slowFrames = 0;
+    fastFrames = 0;
+    cooldown = 0;
+}
+
+size_t QualityGovernor::getLevel(Knob knob) const {
+    return levels[static_cast<size_t>(knob)];
+}
+
+/* A frame only counts as slow or fast while the average agrees, so single spikes do not turn
+   anything. Knobs are lowered in their order and raised in the reverse one. */
+std::optional<Adjustment> QualityGovernor::addFrame(double milliseconds) {
+    smoothedTime = measuredFrames == 0 ? milliseconds : smoothedTime + SMOOTHING * (milliseconds - smoothedTime);
+    measuredFrames++;
+
+    if (cooldown > 0) {
+        cooldown--;
+        return std::nullopt;
+    }
+
+    slowFrames = smoothedTime > target * LOWER_RATIO ? slowFrames + 1 : 0;
+    fastFrames = smoothedTime < target * RAISE_RATIO ? fastFrames + 1 : 0;
+
+    std::optional<Adjustment> adjustment;
+    if (slowFrames >= LOWER_FRAMES) {
+        auto knob = std::find_if(levels.begin(), levels.end(), [](size_t level) { return level < MAX_LEVEL; });
+        if (knob != levels.end()) {
+            adjustment = Adjustment{static_cast<Knob>(knob - levels.begin()), true, ++*knob};
+        }
+    } else if (fastFrames >= RAISE_FRAMES) {
+        auto knob = std::find_if(levels.rbegin(), levels.rend(), [](size_t level) { return level > 0; });
+        if (knob != levels.rend()) {
+            adjustment = Adjustment{static_cast<Knob>(levels.rend() - knob - 1), false, --*knob};
+        }
+    }
+
+    if (adjustment) {
+        slowFrames = 0;
+        fastFrames = 0;
+        cooldown = COOLDOWN_FRAMES;
+    }
+    return adjustment;
+}
+
+/* Subdivision halves the segments of vertex shader splines and doubles the distance between the
+   cuts of geometry shader ones, the level of detail doubles the allowed gap and every step of
+   the point budget takes away a quarter of the requested tail. */
+Settings QualityGovernor::apply(const Settings &requested) const {
+    size_t subdivision = getLevel(Knob::Subdivision);
+    size_t levelOfDetail = getLevel(Knob::LevelOfDetail);
+    size_t pointBudget = getLevel(Knob::PointBudget);
+
+    Settings settings = requested;
+    settings.splineSegments = std::max(1, requested.splineSegments >> subdivision);
+    settings.interpolationDistance = requested.interpolationDistance * static_cast<float>(1 << subdivision);
+    settings.lodPixelError = requested.lodPixelError * static_cast<float>(1 << levelOfDetail);
+    settings.tailPointsNumber = std::max(size_t{1}, requested.tailPointsNumber * (MAX_LEVEL + 1 - pointBudget) /
+                                                        (MAX_LEVEL + 1));
+    return settings;
+}
+
+std::string QualityGovernor::describe() const {
+    std::string description;
+    for (size_t knob = 0; knob < KNOBS_NUMBER; knob++) {
+        if (levels[knob] == 0) {
+            continue;
+        }
+        if (!description.empty()) {
+            description += ", ";
+        }
+        description += getKnobName(static_cast<Knob>(knob)) + std::string(" -") + std::to_string(levels[knob]);
+    }
+    return description.empty() ? "full quality" : description;
+}
+
+} //namespace QualityGovernor
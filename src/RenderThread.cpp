@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <QCoreApplication>
+
+#include "RenderThread.hpp"
+
+namespace RenderThread {
+
+RenderThread::~RenderThread() {
+    stop();
+}
+
+void RenderThread::setCallbacks(Command initialize, Frame frame, Command finish) {
+    initializeCallback = std::move(initialize);
+    frameCallback = std::move(frame);
+    finishCallback = std::move(finish);
+}
+
+void RenderThread::setTargetFrameRate(int framesPerSecond) {
+    targetFrameRate = std::max(1, framesPerSecond);
+}
+
+void RenderThread::post(Command command) {
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex);
+        commands.push_back(std::move(command));
+    }
+    wakeCondition.notify_one();
+}
+
+void RenderThread::wake() {
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex);
+        wakeRequested = true;
+    }
+    wakeCondition.notify_one();
+}
+
+void RenderThread::invoke(Command command) {
+    std::promise<void> executed;
+    std::future<void> result = executed.get_future();
+    post([&command, &executed] {
+        command();
+        executed.set_value();
+    });
+
+    while (result.wait_for(std::chrono::milliseconds(10)) != std::future_status::ready) {
+        QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+    }
+    /* Delivers what the command posted last, before the caller goes on. */
+    QCoreApplication::processEvents(QEventLoop::ExcludeUserInputEvents);
+}
+
+void RenderThread::stop() {
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex);
+        stopFlag = true;
+    }
+    wakeCondition.notify_one();
+    wait();
+}
+
+/* Commands are swapped out under the lock and run without it, so posting never waits for a command. */
+void RenderThread::executeCommands() {
+    {
+        std::lock_guard<std::mutex> lock(commandsMutex);
+        std::swap(commands, executedCommands);
+    }
+    for (auto &command : executedCommands) {
+        command();
+    }
+    executedCommands.clear();
+}
+
+void RenderThread::run() {
+    initializeCallback();
+
+    auto frameDeadline = std::chrono::steady_clock::now();
+    while (!stopFlag.load()) {
+        executeCommands();
+        if (!frameCallback()) {
+            std::unique_lock<std::mutex> lock(commandsMutex);
+            wakeCondition.wait(lock, [this] {
+                return !commands.empty() || wakeRequested || stopFlag.load();
+            });
+            wakeRequested = false;
+            frameDeadline = std::chrono::steady_clock::now();
+            continue;
+        }
+
+        /* Where the swap has already waited for vsync the deadline is usually behind, and a late
+           frame moves the deadline instead of making the next frames hurry. */
+        frameDeadline += std::chrono::microseconds(1000000 / targetFrameRate.load());
+        auto now = std::chrono::steady_clock::now();
+        if (frameDeadline > now) {
+            std::this_thread::sleep_until(frameDeadline);
+        } else {
+            frameDeadline = now;
+        }
+    }
+
+    executeCommands();
+    finishCallback();
+}
+
+} //namespace RenderThread
@@ -0,0 +1,29 @@
+#include <sstream>
+
+#include "RunDescription.hpp"
+
+namespace RunDescription {
+
+std::string getTrajectoryKey(const RunDescription &description, size_t locusIndex) {
+    std::ostringstream key;
+    key << std::hexfloat;
+
+    key << description.system->getAttractorName() << '\n';
+    for (const auto &formula : description.system->getFormulae()) {
+        key << formula << '\n';
+    }
+    for (long double constant : description.constants) {
+        key << constant << ' ';
+    }
+
+    const Model::Point &startPoint = description.startPoints[locusIndex];
+    key << '\n' << startPoint.x << ' ' << startPoint.y << ' ' << startPoint.z << '\n'
+        << description.pointsNumber << ' '
+        << description.timeDelta << ' '
+        << static_cast<int>(description.integrator) << ' '
+        << description.normalizeConstant;
+
+    return key.str();
+}
+
+} //namespace RunDescription
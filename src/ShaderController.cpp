@@ -1,98 +1,238 @@
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <QFile>
+#include <QOpenGLContext>
+
 #include "ShaderController.hpp"
 
 namespace ShaderController {
 
+namespace {
+
+QByteArray readResource(const QString &fileName) {
+    QFile file(fileName);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+} //namespace
+
+ShaderController::ProgramHandle ShaderController::getProgramHandle(Technique technique, GLenum primitive,
+                                                                   bool arcadeMode, bool tailColoringMode,
+                                                                   bool vertexSmoothing) {
+    if (technique == Technique::Density) {
+        return DENSITY_MODE_BIT | (tailColoringMode ? TAIL_COLORING_BIT : 0);
+    }
+    if (technique == Technique::InstancedHeads) {
+        return INSTANCED_HEADS_BIT | (tailColoringMode ? TAIL_COLORING_BIT : 0);
+    }
+    return (primitive == GL_POINTS ? POINTS_BIT : 0) |
+           (arcadeMode ? ARCADE_MODE_BIT : 0) |
+           (tailColoringMode ? TAIL_COLORING_BIT : 0) |
+           (vertexSmoothing ? VERTEX_SMOOTHING_BIT : 0);
+}
+
+ShaderController::ShaderController() :
+    programCache{ShaderProgramCache::ShaderProgramCache::getDefaultDirectory()} {}
+
 void ShaderController::initialize() {
-    gshPoints = new QGLShader(QGLShader::Geometry, &shaderProgram);
-    gshLines = new QGLShader(QGLShader::Geometry, &shaderProgram);
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+    programCache.initialize(QOpenGLContext::currentContext());
+
+    vertexSource = readResource(":/VertexShader.vsh");
+    splineVertexSource = readResource(":/SplineVertexShader.vsh");
+    headVertexSource = readResource(":/HeadVertexShader.vsh");
+    geometryPointsSource = readResource(":/GeometryShaderPoints.gsh");
+    geometryLinesSource = readResource(":/GeometryShaderLines.gsh");
+    fragmentSource = readResource(":/FragmentShader.fsh");
+    frameStateSource = readResource(":/FrameState.glsl");
+
+    functions->glGenBuffers(1, &frameStateBuffer);
+    functions->glBindBuffer(GL_UNIFORM_BUFFER, frameStateBuffer);
+    functions->glBufferData(GL_UNIFORM_BUFFER, sizeof(FrameState), nullptr, GL_DYNAMIC_DRAW);
+    functions->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    functions->glBindBufferBase(GL_UNIFORM_BUFFER, FRAME_STATE_BINDING, frameStateBuffer);
+
+    /* Every program a mode switch can select is linked now, mostly from the binary cache, so that
+       the switch never stalls a frame on the compiler. */
+    for (ProgramHandle handle = 0; handle < PROGRAMS_NUMBER; handle++) {
+        if (isReachable(handle)) {
+            programs[handle] = createProgram(handle);
+        }
+    }
+}
 
-    gshPoints->compileSourceFile(QString(":/GeometryShaderPoints.gsh"));
-    gshLines->compileSourceFile(QString(":/GeometryShaderLines.gsh"));
+/* Density splats and instanced heads only vary by the tail coloring, the other bits belong to tails. */
+bool ShaderController::isReachable(ProgramHandle handle) {
+    ProgramHandle otherBits = handle & ~TAIL_COLORING_BIT;
+    if (otherBits & (DENSITY_MODE_BIT | INSTANCED_HEADS_BIT)) {
+        return otherBits == DENSITY_MODE_BIT || otherBits == INSTANCED_HEADS_BIT;
+    }
+    return true;
+}
+
+/* The mode defines and the shared FrameState block go right after the #version line. */
+QByteArray ShaderController::getShaderSource(const QByteArray &source, ProgramHandle handle) const {
+    QByteArray header;
+    if (handle & ARCADE_MODE_BIT) {
+        header += "#define ARCADE_MODE\n";
+    }
+    if (handle & TAIL_COLORING_BIT) {
+        header += "#define TAIL_COLORING_MODE\n";
+    }
+    if (handle & DENSITY_MODE_BIT) {
+        header += "#define DENSITY_MODE\n";
+    }
+    header += frameStateSource;
+
+    QByteArray result = source;
+    result.insert(result.indexOf('\n') + 1, header);
+    return result;
+}
+
+std::unique_ptr<QGLShaderProgram> ShaderController::createProgram(ProgramHandle handle) {
+    bool vertexSmoothing = handle & VERTEX_SMOOTHING_BIT;
+    bool instancedHeads = handle & INSTANCED_HEADS_BIT;
+    bool geometryStage = !vertexSmoothing && !instancedHeads && !(handle & DENSITY_MODE_BIT);
+    QByteArray vertex = getShaderSource(instancedHeads ? headVertexSource :
+                                        vertexSmoothing ? splineVertexSource : vertexSource, handle);
+    QByteArray geometry = !geometryStage ? QByteArray() :
+        getShaderSource((handle & POINTS_BIT) ? geometryPointsSource : geometryLinesSource, handle);
+    QByteArray fragment = getShaderSource(fragmentSource, handle);
+    QByteArray key = programCache.getKey({vertex, geometry, fragment});
+
+    /* Linking a program without shaders only picks up the link status of the loaded binary. */
+    auto program = std::make_unique<QGLShaderProgram>();
+    if (!programCache.load(program->programId(), key) || !program->link()) {
+        program = std::make_unique<QGLShaderProgram>();
+        program->addShaderFromSourceCode(QGLShader::Vertex, vertex);
+        if (geometryStage) {
+            program->addShaderFromSourceCode(QGLShader::Geometry, geometry);
+        }
+        program->addShaderFromSourceCode(QGLShader::Fragment, fragment);
+
+        /* A fixed location lets one vertex array object serve every program. */
+        program->bindAttributeLocation("vertex", VERTEX_LOCATION);
+        programCache.prepare(program->programId());
+        if (program->link()) {
+            programCache.store(program->programId(), key);
+        }
+    }
 
-    shaderProgram.addShaderFromSourceFile(QGLShader::Vertex, QString(":/VertexShader.vsh"));
-    shaderProgram.addShaderFromSourceFile(QGLShader::Fragment, QString(":/FragmentShader.fsh"));
-    setPrimitive(GL_LINE_STRIP);
+    GLuint programId = program->programId();
+    GLuint frameStateIndex = functions->glGetUniformBlockIndex(programId, "FrameState");
+    functions->glUniformBlockBinding(programId, frameStateIndex, FRAME_STATE_BINDING);
 
-    shaderProgram.link();
+    program->bind();
+    program->setUniformValue(program->uniformLocation("locusData"), LOCUS_DATA_TEXTURE_UNIT);
+    program->setUniformValue(program->uniformLocation("blockBounds"), BLOCK_BOUNDS_TEXTURE_UNIT);
+    if (vertexSmoothing || instancedHeads) {
+        program->setUniformValue(program->uniformLocation("points"), POINTS_TEXTURE_UNIT);
+    }
+    if (instancedHeads) {
+        program->setUniformValue(program->uniformLocation("locusSizes"), LOCUS_SIZES_TEXTURE_UNIT);
+    }
+    program->release();
+
+    return program;
+}
+
+template <typename T>
+void ShaderController::updateState(T &field, const T &value) {
+    if (field != value) {
+        field = value;
+        frameStateChanged = true;
+    }
 }
 
 void ShaderController::startWork() {
-    shaderProgram.bind();
-    shaderProgram.enableAttributeArray("vertex");
+    programs[currentProgram]->bind();
+
+    if (frameStateChanged) {
+        functions->glBindBuffer(GL_UNIFORM_BUFFER, frameStateBuffer);
+        functions->glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(FrameState), &frameState);
+        functions->glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        frameStateChanged = false;
+    }
 }
 
 void ShaderController::endWork() {
-    shaderProgram.disableAttributeArray("vertex");
-    shaderProgram.release();
+    programs[currentProgram]->release();
 }
 
-void ShaderController::setVertex() {
-    shaderProgram.setAttributeArray("vertex", GL_FLOAT, 0, 3);
+void ShaderController::setProgram(ProgramHandle handle) {
+    currentProgram = handle;
 }
 
-void ShaderController::setMatrix(const QMatrix4x4 &matrix) {
-    shaderProgram.setUniformValue("matrix", matrix);
+/* Records the layout of the bound vertex buffer, four normalised 16-bit values per point,
+   in the bound vertex array object. */
+void ShaderController::setVertex() {
+    functions->glEnableVertexAttribArray(VERTEX_LOCATION);
+    functions->glVertexAttribPointer(VERTEX_LOCATION, 3, GL_UNSIGNED_SHORT, GL_TRUE, 4 * sizeof(GLushort), nullptr);
 }
 
-void ShaderController::setArcadeMode(bool enabled) {
-    shaderProgram.setUniformValue("arcadeMode", enabled);
+void ShaderController::setMatrix(const QMatrix4x4 &matrix) {
+    if (std::memcmp(frameState.matrix, matrix.constData(), sizeof(frameState.matrix)) != 0) {
+        std::memcpy(frameState.matrix, matrix.constData(), sizeof(frameState.matrix));
+        frameStateChanged = true;
+    }
 }
 
 void ShaderController::setStartTailSize(float size) {
-    shaderProgram.setUniformValue("startTailSize", size);
+    updateState(frameState.startTailSize, size);
 }
 
 void ShaderController::setFinalTailSize(float size) {
-    shaderProgram.setUniformValue("finalTailSize", size);
+    updateState(frameState.finalTailSize, size);
 }
 
-void ShaderController::setTailLength(size_t length) {
-    shaderProgram.setUniformValue("tailLength", static_cast<int>(length));
+void ShaderController::setRegionSize(size_t size) {
+    updateState(frameState.regionSize, static_cast<GLint>(size));
 }
 
-void ShaderController::setStartVertexIndex(size_t index) {
-    shaderProgram.setUniformValue("startIndex", static_cast<int>(index));
+void ShaderController::setTrajectoriesNumber(size_t number) {
+    updateState(frameState.trajectoriesNumber, static_cast<GLint>(number));
 }
 
-void ShaderController::setTailColoringMode(bool enabled) {
-    shaderProgram.setUniformValue("tailColoringMode", enabled);
+void ShaderController::setColors(const QVector<QVector4D> &colors) {
+    int colorsNumber = std::min(colors.size(), FrameState::MAX_COLORS_NUMBER);
+    updateState(frameState.colorsNumber, static_cast<GLint>(colorsNumber));
+
+    for (int i = 0; i < colorsNumber; i++) {
+        const GLfloat color[4] = { colors[i].x(), colors[i].y(), colors[i].z(), colors[i].w() };
+        if (std::memcmp(frameState.colors[i], color, sizeof(color)) != 0) {
+            std::memcpy(frameState.colors[i], color, sizeof(color));
+            frameStateChanged = true;
+        }
+    }
 }
 
-void ShaderController::setTrajectoryIndex(size_t index) {
-    shaderProgram.setUniformValue("trajectoryIndex", static_cast<int>(index));
+void ShaderController::setInterpolationDistance(float distance) {
+    updateState(frameState.interpolationDist, distance);
 }
 
-void ShaderController::setTrajectoriesNumber(size_t number) {
-    shaderProgram.setUniformValue("trajectoriesNumber", static_cast<int>(number));
+void ShaderController::setSplineSegments(int segments) {
+    updateState(frameState.splineSegments, static_cast<GLint>(segments));
 }
 
-void ShaderController::setColors(const QVector<QVector4D> &colors) {
-    shaderProgram.setUniformValue("colorsNumber", colors.size());
-    shaderProgram.setUniformValueArray("colors", colors.constData(), colors.size());
+void ShaderController::setBlockLayout(size_t blockSize, size_t blocksPerRegion) {
+    updateState(frameState.blockSize, static_cast<GLint>(blockSize));
+    updateState(frameState.blocksPerRegion, static_cast<GLint>(blocksPerRegion));
 }
 
-void ShaderController::setInterpolationDistance(float distance) {
-    shaderProgram.setUniformValue("interpolationDist", distance);
+void ShaderController::setCurrentTime(size_t time) {
+    size_t maxTime = static_cast<size_t>(std::numeric_limits<GLint>::max());
+    updateState(frameState.currentTime, static_cast<GLint>(std::min(time, maxTime)));
 }
 
-void ShaderController::setPrimitive(GLenum primitive) {
-    shaderProgram.release();
-
-    bool isLines = shaderProgram.shaders().contains(gshLines);
-    bool isPoints = shaderProgram.shaders().contains(gshPoints);
-    if (primitive == GL_POINTS && !isPoints) {
-        if (isLines) {
-            shaderProgram.removeShader(gshLines);
-        }
-        shaderProgram.addShader(gshPoints);
-    } else if (primitive == GL_LINE_STRIP && !isLines) {
-        if (isPoints) {
-            shaderProgram.removeShader(gshPoints);
-        }
-        shaderProgram.addShader(gshLines);
-    }
+void ShaderController::setTailPointsNumber(size_t number) {
+    updateState(frameState.tailPointsNumber, static_cast<GLint>(number));
+}
 
-    shaderProgram.bind();
+void ShaderController::setRingSize(size_t size) {
+    updateState(frameState.ringSize, static_cast<GLint>(size));
 }
 
 } //namespace ShaderController
@@ -0,0 +1,125 @@
+#include <cstring>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include "ShaderProgramCache.hpp"
+
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#endif
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+namespace ShaderProgramCache {
+
+ShaderProgramCache::ShaderProgramCache(QString directory_) :
+    directory{std::move(directory_)} {}
+
+QString ShaderProgramCache::getDefaultDirectory() {
+    return QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/shaders";
+}
+
+void ShaderProgramCache::initialize(QOpenGLContext *context) {
+    QOpenGLFunctions *functions = context->functions();
+    driverIdentity = QByteArray(reinterpret_cast<const char *>(functions->glGetString(GL_VENDOR))) + '\n' +
+                     QByteArray(reinterpret_cast<const char *>(functions->glGetString(GL_RENDERER))) + '\n' +
+                     QByteArray(reinterpret_cast<const char *>(functions->glGetString(GL_VERSION)));
+
+    QSurfaceFormat format = context->format();
+    bool supported = format.version() >= qMakePair(4, 1) || context->hasExtension("GL_ARB_get_program_binary");
+    if (!supported) {
+        return;
+    }
+
+    getProgramBinary = reinterpret_cast<GetProgramBinary>(context->getProcAddress("glGetProgramBinary"));
+    programBinary = reinterpret_cast<ProgramBinary>(context->getProcAddress("glProgramBinary"));
+    programParameteri = reinterpret_cast<ProgramParameteri>(context->getProcAddress("glProgramParameteri"));
+    getProgramiv = reinterpret_cast<GetProgramiv>(context->getProcAddress("glGetProgramiv"));
+    if (getProgramBinary == nullptr || programBinary == nullptr ||
+        programParameteri == nullptr || getProgramiv == nullptr) {
+        getProgramBinary = nullptr;
+        return;
+    }
+
+    QDir().mkpath(directory);
+}
+
+QByteArray ShaderProgramCache::getKey(const QVector<QByteArray> &sources) const {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(driverIdentity);
+    for (const auto &source : sources) {
+        hash.addData(QByteArray::number(source.size()) + '\n');
+        hash.addData(source);
+    }
+    return hash.result().toHex();
+}
+
+QString ShaderProgramCache::getFilePath(const QByteArray &key) const {
+    return directory + "/" + QString::fromLatin1(key) + ".bin";
+}
+
+bool ShaderProgramCache::load(GLuint program, const QByteArray &key) const {
+    if (getProgramBinary == nullptr) {
+        return false;
+    }
+
+    QFile file(getFilePath(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QByteArray content = file.readAll();
+
+    GLenum format;
+    if (content.size() <= static_cast<int>(sizeof(format))) {
+        return false;
+    }
+    std::memcpy(&format, content.constData(), sizeof(format));
+
+    programBinary(program, format, content.constData() + sizeof(format),
+                  static_cast<GLsizei>(content.size() - sizeof(format)));
+
+    GLint linked = GL_FALSE;
+    getProgramiv(program, GL_LINK_STATUS, &linked);
+    if (linked != GL_TRUE) {
+        /* The driver rejects binaries of other builds even with a matching identity, so the stale file goes. */
+        file.remove();
+        return false;
+    }
+    return true;
+}
+
+void ShaderProgramCache::prepare(GLuint program) const {
+    if (getProgramBinary != nullptr) {
+        programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+}
+
+void ShaderProgramCache::store(GLuint program, const QByteArray &key) const {
+    if (getProgramBinary == nullptr) {
+        return;
+    }
+
+    GLint length = 0;
+    getProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return;
+    }
+
+    GLenum format;
+    QByteArray content(static_cast<int>(sizeof(format)) + length, '\0');
+    getProgramBinary(program, length, &length, &format, content.data() + sizeof(format));
+    std::memcpy(content.data(), &format, sizeof(format));
+    content.resize(static_cast<int>(sizeof(format)) + length);
+
+    QSaveFile file(getFilePath(key));
+    if (file.open(QIODevice::WriteOnly)) {
+        file.write(content);
+        file.commit();
+    }
+}
+
+} //namespace ShaderProgramCache
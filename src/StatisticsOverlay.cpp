@@ -0,0 +1,108 @@
+#include <algorithm>
+#include <QOpenGLContext>
+#include <QFontMetrics>
+#include <QPainter>
+#include <QStringList>
+
+#include "StatisticsOverlay.hpp"
+
+namespace StatisticsOverlay {
+
+using FrameStatistics::Section;
+
+void StatisticsOverlay::initialize() {
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+
+    program = std::make_unique<QGLShaderProgram>();
+    program->addShaderFromSourceFile(QGLShader::Vertex, ":/Overlay.vsh");
+    program->addShaderFromSourceFile(QGLShader::Fragment, ":/Overlay.fsh");
+    program->link();
+
+    vertexArray.create();
+    functions->glGenTextures(1, &texture);
+}
+
+/* One line per section that ran, with its CPU and GPU times in milliseconds. */
+void StatisticsOverlay::update(const FrameStatistics::FrameTimes &mean, const QString &status) {
+    QStringList lines = { QString("%1 %2 %3").arg("", -10).arg("cpu", 8).arg("gpu", 8) };
+    for (size_t section = 0; section < FrameStatistics::SECTIONS_NUMBER; section++) {
+        if (mean.cpu[section] < 0 && mean.gpu[section] < 0) {
+            continue;
+        }
+        auto format = [](double value) {
+            return value < 0 ? QString("-") : QString::number(value, 'f', 2);
+        };
+        lines.push_back(QString("%1 %2 %3")
+                            .arg(FrameStatistics::getSectionName(static_cast<Section>(section)), -10)
+                            .arg(format(mean.cpu[section]), 8)
+                            .arg(format(mean.gpu[section]), 8));
+    }
+    if (!status.isEmpty()) {
+        lines.push_back(status);
+    }
+
+    QFont font("Monospace");
+    font.setStyleHint(QFont::TypeWriter);
+    QFontMetrics metrics(font);
+
+    int width = 0;
+    for (const auto &line : lines) {
+        width = std::max(width, metrics.boundingRect(line).width());
+    }
+
+    image = QImage(width + 2 * MARGIN, metrics.lineSpacing() * lines.size() + 2 * MARGIN, QImage::Format_RGBA8888_Premultiplied);
+    image.fill(QColor(0, 0, 0, 160));
+
+    QPainter painter(&image);
+    painter.setFont(font);
+    painter.setPen(Qt::white);
+    for (int i = 0; i < lines.size(); i++) {
+        painter.drawText(MARGIN, MARGIN + metrics.ascent() + i * metrics.lineSpacing(), lines[i]);
+    }
+    painter.end();
+
+    functions->glBindTexture(GL_TEXTURE_2D, texture);
+    functions->glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, image.width(), image.height(), 0,
+                            GL_RGBA, GL_UNSIGNED_BYTE, image.constBits());
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    functions->glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    functions->glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+/* The image keeps its size in pixels, so the quad is placed in normalized device coordinates
+   computed from the viewport. */
+void StatisticsOverlay::draw() {
+    if (image.isNull()) {
+        return;
+    }
+
+    GLint viewport[4];
+    functions->glGetIntegerv(GL_VIEWPORT, viewport);
+    GLboolean depthTestEnabled = functions->glIsEnabled(GL_DEPTH_TEST);
+
+    functions->glDisable(GL_DEPTH_TEST);
+    functions->glEnable(GL_BLEND);
+    functions->glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+
+    float width = 2.0f * image.width() / viewport[2];
+    float height = 2.0f * image.height() / viewport[3];
+
+    program->bind();
+    program->setUniformValue("rectangle", QVector4D(-1, 1 - height, width, height));
+    program->setUniformValue("overlay", 0);
+    functions->glActiveTexture(GL_TEXTURE0);
+    functions->glBindTexture(GL_TEXTURE_2D, texture);
+    vertexArray.bind();
+    functions->glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    vertexArray.release();
+    functions->glBindTexture(GL_TEXTURE_2D, 0);
+    program->release();
+
+    functions->glDisable(GL_BLEND);
+    if (depthTestEnabled) {
+        functions->glEnable(GL_DEPTH_TEST);
+    }
+}
+
+} //namespace StatisticsOverlay
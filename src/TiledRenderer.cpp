@@ -0,0 +1,96 @@
+#include <algorithm>
+#include <cstring>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+
+#include "PngStreamWriter.hpp"
+#include "TiledRenderer.hpp"
+
+namespace TiledRenderer {
+
+void TiledRenderer::initialize() {
+    functions = QOpenGLContext::currentContext()->versionFunctions<QOpenGLFunctions_3_3_Core>();
+    functions->initializeOpenGLFunctions();
+
+    GLint maxRenderbufferSize = 0;
+    GLint maxViewportSize[2] = {};
+    functions->glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &maxRenderbufferSize);
+    functions->glGetIntegerv(GL_MAX_VIEWPORT_DIMS, maxViewportSize);
+    tileSize = std::min({TILE_SIZE, maxRenderbufferSize, maxViewportSize[0], maxViewportSize[1]});
+}
+
+/* Scaling and shifting clip space after the projection keeps the perspective of the full view,
+   so the tiles fit together without seams. */
+QMatrix4x4 TiledRenderer::getTileMatrix(const QMatrix4x4 &matrix, int width, int height,
+                                        int x, int y, int tileWidth, int tileHeight) {
+    float left = 2.0f * x / width - 1;
+    float right = 2.0f * (x + tileWidth) / width - 1;
+    float bottom = 2.0f * y / height - 1;
+    float top = 2.0f * (y + tileHeight) / height - 1;
+
+    QMatrix4x4 tile;
+    tile.translate(-(right + left) / (right - left), -(top + bottom) / (top - bottom));
+    tile.scale(2 / (right - left), 2 / (top - bottom));
+    return tile * matrix;
+}
+
+/* Tiles at the right and bottom edges are drawn whole and cut when read back, so that pixels
+   have the same size in every tile. Rows are read bottom up and written top down. */
+void TiledRenderer::render(const QMatrix4x4 &matrix, int width, int height, const std::string &filename,
+                           const std::function<void (const QMatrix4x4 &)> &drawFunc) {
+    PngStreamWriter::PngStreamWriter writer;
+    writer.open(filename, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+
+    GLint previousViewport[4];
+    functions->glGetIntegerv(GL_VIEWPORT, previousViewport);
+    GLint previousAlignment = 0;
+    functions->glGetIntegerv(GL_PACK_ALIGNMENT, &previousAlignment);
+    functions->glPixelStorei(GL_PACK_ALIGNMENT, 1);
+
+    QOpenGLFramebufferObject framebuffer(tileSize, tileSize, QOpenGLFramebufferObject::CombinedDepthStencil);
+    framebuffer.bind();
+    functions->glViewport(0, 0, tileSize, tileSize);
+
+    size_t rowSize = 3 * static_cast<size_t>(width);
+    tilePixels.resize(3 * static_cast<size_t>(tileSize) * tileSize);
+    strip.resize(rowSize * tileSize);
+
+    auto restore = [&] {
+        framebuffer.release();
+        functions->glPixelStorei(GL_PACK_ALIGNMENT, previousAlignment);
+        functions->glViewport(previousViewport[0], previousViewport[1], previousViewport[2], previousViewport[3]);
+        strip.clear();
+        strip.shrink_to_fit();
+    };
+
+    try {
+        for (int stripTop = 0; stripTop < height; stripTop += tileSize) {
+            int stripHeight = std::min(tileSize, height - stripTop);
+            int y = height - stripTop - tileSize;
+
+            for (int x = 0; x < width; x += tileSize) {
+                int tileWidth = std::min(tileSize, width - x);
+                drawFunc(getTileMatrix(matrix, width, height, x, y, tileSize, tileSize));
+
+                functions->glReadPixels(0, tileSize - stripHeight, tileWidth, stripHeight, GL_RGB, GL_UNSIGNED_BYTE,
+                                        tilePixels.data());
+                for (int row = 0; row < stripHeight; row++) {
+                    std::memcpy(&strip[(stripHeight - 1 - row) * rowSize + 3 * static_cast<size_t>(x)],
+                                &tilePixels[3 * static_cast<size_t>(row) * tileWidth], 3 * static_cast<size_t>(tileWidth));
+                }
+            }
+
+            for (int row = 0; row < stripHeight; row++) {
+                writer.writeRow(&strip[row * rowSize]);
+            }
+        }
+    } catch (...) {
+        restore();
+        throw;
+    }
+    restore();
+
+    writer.close();
+}
+
+} //namespace TiledRenderer
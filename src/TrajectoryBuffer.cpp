@@ -0,0 +1,49 @@
+#include <algorithm>
+
+#include "TrajectoryBuffer.hpp"
+
+namespace TrajectoryBuffer {
+
+void convertAndNormalize(const Model::Point *points, size_t count, float normalizeConstant, float *out) {
+    const float scale = 1 / normalizeConstant;
+
+    for (size_t i = 0; i < count; i++) {
+        out[3 * i]     = static_cast<float>(points[i].x);
+        out[3 * i + 1] = static_cast<float>(points[i].y);
+        out[3 * i + 2] = static_cast<float>(points[i].z);
+    }
+    /* Kept apart from the long double loads so that this loop vectorises. */
+    for (size_t i = 0; i < 3 * count; i++) {
+        out[i] *= scale;
+    }
+}
+
+TrajectoryBuffer::TrajectoryBuffer(size_t capacity) :
+    coordinates{new float[3 * capacity], std::default_delete<float[]>()},
+    pointsSize{0},
+    pointsCapacity{capacity} {}
+
+TrajectoryBuffer::TrajectoryBuffer(std::shared_ptr<float> points, size_t size) :
+    coordinates{std::move(points)},
+    pointsSize{size},
+    pointsCapacity{size} {}
+
+void TrajectoryBuffer::append(const Model::Point *points, size_t count, float normalizeConstant) {
+    count = std::min(count, pointsCapacity - pointsSize);
+    convertAndNormalize(points, count, normalizeConstant, coordinates.get() + 3 * pointsSize);
+    pointsSize += count;
+}
+
+const float *TrajectoryBuffer::data() const {
+    return coordinates.get();
+}
+
+size_t TrajectoryBuffer::size() const {
+    return pointsSize;
+}
+
+size_t TrajectoryBuffer::capacity() const {
+    return pointsCapacity;
+}
+
+} //namespace TrajectoryBuffer
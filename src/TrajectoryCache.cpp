@@ -0,0 +1,71 @@
+#include "TrajectoryCache.hpp"
+
+namespace TrajectoryCache {
+
+TrajectoryCache::TrajectoryCache(size_t memoryBudget) :
+    budget{memoryBudget},
+    usage{0} {}
+
+size_t TrajectoryCache::getMemorySize(const TrajectoryBuffer::TrajectoryBuffer &buffer) {
+    return buffer.capacity() * 3 * sizeof(float);
+}
+
+std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> TrajectoryCache::find(const std::string &key) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto found = entriesByKey.find(key);
+    if (found == entriesByKey.end()) {
+        return nullptr;
+    }
+    entries.splice(entries.begin(), entries, found->second);
+
+    return found->second->second;
+}
+
+void TrajectoryCache::insert(const std::string &key, std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (getMemorySize(*buffer) > budget) {
+        return;
+    }
+
+    auto found = entriesByKey.find(key);
+    if (found != entriesByKey.end()) {
+        usage -= getMemorySize(*found->second->second);
+        entries.erase(found->second);
+        entriesByKey.erase(found);
+    }
+
+    usage += getMemorySize(*buffer);
+    entries.emplace_front(key, std::move(buffer));
+    entriesByKey.emplace(key, entries.begin());
+
+    evict();
+}
+
+void TrajectoryCache::setMemoryBudget(size_t memoryBudget) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    budget = memoryBudget;
+    evict();
+}
+
+size_t TrajectoryCache::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return usage;
+}
+
+size_t TrajectoryCache::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void TrajectoryCache::evict() {
+    while (usage > budget) {
+        usage -= getMemorySize(*entries.back().second);
+        entriesByKey.erase(entries.back().first);
+        entries.pop_back();
+    }
+}
+
+} //namespace TrajectoryCache
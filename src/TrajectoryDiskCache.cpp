@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "TrajectoryDiskCache.hpp"
+
+namespace TrajectoryDiskCache {
+
+namespace {
+
+constexpr char FILE_MAGIC[8] = {'D', 'Y', 'N', 'S', 'Y', 'S', 'T', 'R'};
+constexpr uint32_t FILE_VERSION = 1;
+constexpr char FILE_SUFFIX[] = ".traj";
+
+/* Written next to the entry and renamed over it once complete, so readers never see half a file. */
+constexpr char PARTIAL_SUFFIX[] = ".part";
+
+/* Points start at a multiple of this offset, which keeps them aligned in the mapping. */
+constexpr uint64_t POINTS_ALIGNMENT = 64;
+
+constexpr uint64_t POINT_SIZE = 3 * sizeof(float);
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t floatSize;
+    uint64_t keySize;
+    uint64_t pointsNumber;
+    uint64_t pointsOffset;
+};
+
+uint64_t getKeyHash(const std::string &key) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char symbol : key) {
+        hash ^= symbol;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+uint64_t getPointsOffset(uint64_t keySize) {
+    uint64_t offset = sizeof(FileHeader) + keySize;
+    return offset + (POINTS_ALIGNMENT - offset % POINTS_ALIGNMENT) % POINTS_ALIGNMENT;
+}
+
+/* Checks the header and the key against a file of fileSize bytes, without trusting any of the
+   header fields before they are compared. */
+bool isValidEntry(const char *bytes, uint64_t fileSize, const std::string &key) {
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    return std::memcmp(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) == 0 &&
+           header.version == FILE_VERSION &&
+           header.floatSize == sizeof(float) &&
+           header.keySize == key.size() &&
+           header.pointsOffset == getPointsOffset(header.keySize) &&
+           header.pointsOffset <= fileSize &&
+           (fileSize - header.pointsOffset) % POINT_SIZE == 0 &&
+           (fileSize - header.pointsOffset) / POINT_SIZE == header.pointsNumber &&
+           std::memcmp(bytes + sizeof(header), key.data(), key.size()) == 0;
+}
+
+} //namespace
+
+TrajectoryDiskCache::TrajectoryDiskCache(std::string directory_, size_t diskBudget) :
+    directory{std::move(directory_)},
+    budget{diskBudget} {
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+}
+
+std::string TrajectoryDiskCache::getFilePath(const std::string &key) const {
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(getKeyHash(key)));
+    return directory + "/" + name + FILE_SUFFIX;
+}
+
+std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> TrajectoryDiskCache::find(const std::string &key) const {
+    std::string path = getFilePath(key);
+    int file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return nullptr;
+    }
+    struct stat status;
+    if (fstat(file, &status) != 0 || static_cast<uint64_t>(status.st_size) < sizeof(FileHeader)) {
+        close(file);
+        return nullptr;
+    }
+    size_t fileSize = static_cast<size_t>(status.st_size);
+    void *mapped = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if (mapped == MAP_FAILED) {
+        return nullptr;
+    }
+
+    const char *bytes = static_cast<const char *>(mapped);
+    if (!isValidEntry(bytes, fileSize, key)) {
+        munmap(mapped, fileSize);
+        return nullptr;
+    }
+
+    /* Eviction goes by modification time, so a hit marks the file as used. */
+    std::error_code error;
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+    FileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.pointsNumber == 0) {
+        munmap(mapped, fileSize);
+        return std::make_shared<const TrajectoryBuffer::TrajectoryBuffer>(0);
+    }
+
+    float *points = reinterpret_cast<float *>(static_cast<char *>(mapped) + header.pointsOffset);
+    std::shared_ptr<float> mappedPoints(points, [mapped, fileSize](float *) {
+        munmap(mapped, fileSize);
+    });
+    return std::make_shared<const TrajectoryBuffer::TrajectoryBuffer>(std::move(mappedPoints), header.pointsNumber);
+}
+
+void TrajectoryDiskCache::store(const std::string &key, const TrajectoryBuffer::TrajectoryBuffer &buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t pointsSize = buffer.size() * POINT_SIZE;
+    if (budget == 0 || pointsSize > budget) {
+        return;
+    }
+
+    FileHeader header;
+    std::memcpy(header.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+    header.version = FILE_VERSION;
+    header.floatSize = sizeof(float);
+    header.keySize = key.size();
+    header.pointsNumber = buffer.size();
+    header.pointsOffset = getPointsOffset(header.keySize);
+
+    std::string path = getFilePath(key);
+    std::string partialPath = path + PARTIAL_SUFFIX;
+    std::error_code error;
+
+    std::ofstream file(partialPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(key.data(), static_cast<std::streamsize>(key.size()));
+    std::vector<char> padding(header.pointsOffset - sizeof(header) - header.keySize, '\0');
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(reinterpret_cast<const char *>(buffer.data()), static_cast<std::streamsize>(pointsSize));
+    file.close();
+    if (!file) {
+        std::filesystem::remove(partialPath, error);
+        return;
+    }
+    std::filesystem::rename(partialPath, path, error);
+    if (error) {
+        std::filesystem::remove(partialPath, error);
+        return;
+    }
+
+    evict();
+}
+
+void TrajectoryDiskCache::setDiskBudget(size_t diskBudget) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    budget = diskBudget;
+    evict();
+}
+
+void TrajectoryDiskCache::evict() {
+    struct Entry {
+        std::filesystem::file_time_type time;
+        uintmax_t size;
+        std::filesystem::path path;
+    };
+    std::vector<Entry> entries;
+    uintmax_t usage = 0;
+
+    std::error_code error;
+    for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (it->path().extension() != FILE_SUFFIX || !it->is_regular_file(error)) {
+            continue;
+        }
+        Entry entry{it->last_write_time(error), it->file_size(error), it->path()};
+        if (!error) {
+            usage += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    /* Newest first, so the least recently used files are at the back. */
+    std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) {
+        return a.time > b.time;
+    });
+    while (usage > budget && !entries.empty()) {
+        std::filesystem::remove(entries.back().path, error);
+        usage -= entries.back().size;
+        entries.pop_back();
+    }
+}
+
+} //namespace TrajectoryDiskCache
@@ -8,16 +8,23 @@
 #include "PointsViewQGLWidget.hpp"
 #include "WindowPreferences.hpp"
 
-Window::Window(QWidget *parent) : QWidget(parent), ui(new Ui::Window) {
-    auto dynamicSystemsVector = DynamicSystems::getDefaultSystems<LambdaPushBackAction>();
+Window::Window(QWidget *parent) :
+    QWidget(parent),
+    currentRunId{0},
+    displayedTime{0},
+    computedChunks{CHUNKS_QUEUE_CAPACITY},
+    trajectoryCache{static_cast<size_t>(prefs.model.cacheMemoryBudget) << 20},
+    trajectoryDiskCache{(QStandardPaths::writableLocation(QStandardPaths::CacheLocation) + "/trajectories").toStdString(),
+                        static_cast<size_t>(prefs.model.diskCacheBudget) << 20},
+    ui(new Ui::Window) {
+
+    auto dynamicSystemsVector = DynamicSystems::getDefaultSystems();
     dynamicSystemsVector.push_back(getCustomSystem({"1", "1", "1"}));
     for (auto &system : dynamicSystemsVector) {
         QString name = system.getAttractorName().data();
-        dynamicSystems.emplace(std::move(name), std::move(system));
+        dynamicSystems.emplace(std::move(name), std::make_shared<const DynamicSystemWrapper>(std::move(system)));
     }
 
-    task = new CountPointsTask(*this);
-
     windowPreferences = nullptr;
 
     setFocusPolicy(Qt::StrongFocus);
@@ -51,7 +58,7 @@ void collectAllConstants(QLayout *currentLayout, std::vector<long double> &const
 }
 
 Window::DynamicSystemWrapper Window::getCustomSystem(const std::array<std::string, 3> &expressions) {
-    return DynamicSystemParser::getDynamicSystem<LambdaPushBackAction>("Custom system", expressions);
+    return DynamicSystemParser::getDynamicSystem("Custom system", expressions);
 }
 
 void Window::insertConstants(const std::vector<std::pair<std::string, std::vector<long double>>> &goodParams) {
@@ -73,54 +80,218 @@ void Window::insertExpressions(std::array<std::string_view, 3> array, bool readO
 void Window::afterCountPointsUIUpdate() {
     timeValue = 0;
     ui->progressSlider->setValue(timeValue);
+    sliderClock.start();
     sliderTimer->start();
 
     clearFocus();
 
     ui->progressSlider->setMaximum(std::min(10000, prefs.model.pointsNumber));
+    ui->progressSlider->setEnabled(!liveMode);
 }
 
-void Window::updateOpenGLWidget(QVector<QVector3D> buffer) {
-    ui->pointsViewer->addNewLocus(std::move(buffer));
+void Window::consumeComputedChunks() {
+    TrajectoryBuffer::TrajectoryChunk chunk;
+    for (size_t i = 0; i < MAX_CHUNKS_PER_UPDATE && computedChunks.tryPop(chunk); i++) {
+        if (chunk.runId == currentRunId.load()) {
+            ui->pointsViewer->addChunk(chunk);
+        }
+    }
 }
 
-CountPointsTask::CountPointsTask(Window &wind_) : wind(wind_) {
-    QObject::connect(this, &CountPointsTask::updater, &wind, &Window::updateOpenGLWidget, Qt::QueuedConnection);
+void Window::updateComputationState() {
+    if (!countPointsJob.isValid()) {
+        return;
+    }
+
+    if (!countPointsJob.isFinished()) {
+        if (liveMode) {
+            ui->buildModelButton->setText("Restart modeling (live)");
+            return;
+        }
+        int percent = static_cast<int>(countPointsJob.progress() * 100);
+        ui->buildModelButton->setText(QString("Restart modeling (%1%)").arg(percent));
+        return;
+    }
+
+    std::exception_ptr error = countPointsJob.error();
+    countPointsJob = JobSystem::JobHandle{};
+    ui->buildModelButton->setText("Start modeling");
+
+    if (error != nullptr) {
+        try {
+            std::rethrow_exception(error);
+        } catch (const std::exception &exception) {
+            QMessageBox::warning(this, "Modeling failed", exception.what());
+        }
+    }
 }
 
-void CountPointsTask::run() {
-    if (wind.ui->modelsComboBox->currentText() == "Custom system") {
-        wind.dynamicSystems.erase("Custom system");
+RunDescription::RunDescription Window::captureRunDescription() {
+    if (ui->modelsComboBox->currentText() == "Custom system") {
+        const std::string exprX = ui->firstExpr->text().toStdString();
+        const std::string exprY = ui->secondExpr->text().toStdString();
+        const std::string exprZ = ui->thirdExpr->text().toStdString();
+
+        dynamicSystems["Custom system"] = std::make_shared<const DynamicSystemWrapper>(getCustomSystem({exprX, exprY, exprZ}));
+    }
 
-        const std::string exprX = wind.ui->firstExpr->text().toStdString();
-        const std::string exprY = wind.ui->secondExpr->text().toStdString();
-        const std::string exprZ = wind.ui->thirdExpr->text().toStdString();
+    RunDescription::RunDescription description;
+    description.system = dynamicSystems.at(ui->modelsComboBox->currentText());
+    collectAllConstants(ui->constantsHolderLayout, description.constants);
 
-        wind.dynamicSystems.emplace("Custom system", wind.getCustomSystem({exprX, exprY, exprZ}));
+    for (size_t i = 0; i < prefs.visualization.locusNumber; i++) {
+        long double offset = prefs.model.startPointDelta * i;
+        description.startPoints.push_back(Model::Point{prefs.model.startPoint.x + offset,
+                                                       prefs.model.startPoint.y + offset,
+                                                       prefs.model.startPoint.z + offset});
     }
+    description.pointsNumber      = prefs.model.pointsNumber;
+    description.chunkPointsNumber = prefs.model.chunkPointsNumber;
+    description.timeDelta         = prefs.model.deltaTime;
+    description.integrator        = Model::Integrator::RungeKutta4;
+    description.normalizeConstant = prefs.model.divNormalization;
+    description.live              = prefs.model.liveMode;
+
+    return description;
+}
 
-    Window::DynamicSystemWrapper &system = wind.dynamicSystems.at(wind.ui->modelsComboBox->currentText());
+CountPointsTask::CountPointsTask(const RunDescription::RunDescription &description_, size_t runId_,
+                                 ChunksQueue &chunks_, TrajectoryCache::TrajectoryCache &cache_,
+                                 TrajectoryDiskCache::TrajectoryDiskCache &diskCache_,
+                                 const std::atomic<size_t> &displayedTime_) :
+    description(description_),
+    runId(runId_),
+    chunks(chunks_),
+    cache(cache_),
+    diskCache(diskCache_),
+    displayedTime(displayedTime_) {}
+
+bool CountPointsTask::pushChunk(TrajectoryBuffer::TrajectoryChunk &&chunk, const JobSystem::CancellationToken &token) {
+    while (!chunks.tryPush(std::move(chunk))) {
+        if (token.isCancelled()) {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
 
-    for (size_t i = 0; i < wind.prefs.visualization.locusNumber; i++) {
-        QVector<QVector3D> buffer;
-        buffer.reserve(wind.prefs.model.pointsNumber);
-        long double offset = wind.prefs.model.startPointDelta * i;
+/* Computes every locus in small chunks just ahead of the displayed time, until cancelled. Chunks
+   own their points, since nothing but the tails on the GPU is kept. */
+void CountPointsTask::runLive(const JobSystem::CancellationToken &token) {
+    const DynamicSystems::DynamicSystem &system = *description.system;
+    const size_t locusNumber = description.startPoints.size();
 
-        std::vector<long double> constants;
-        collectAllConstants(wind.ui->constantsHolderLayout, constants);
+    std::vector<Model::Point> points = description.startPoints;
+    std::vector<size_t> computed(locusNumber, 0);
+    std::vector<bool> finished(locusNumber, false);
 
-        auto pushBackVector = DynamicSystemWrapper_n::getPushBackAndNormalizeLambda(buffer,
-                                                                                    wind.prefs.model.divNormalization);
+    while (!token.isCancelled()) {
+        size_t target = displayedTime.load() + LIVE_LEAD_POINTS;
+        bool idle = true;
 
-        system.compute(std::move(pushBackVector),
-                       Model::Point{wind.prefs.model.startPoint.x + offset,
-                                    wind.prefs.model.startPoint.y + offset,
-                                    wind.prefs.model.startPoint.z + offset},
-                       wind.prefs.model.pointsNumber,
-                       wind.prefs.model.deltaTime,
-                       constants);
+        for (size_t i = 0; i < locusNumber; i++) {
+            if (finished[i] || computed[i] >= target) {
+                continue;
+            }
+            idle = false;
+
+            int requested = static_cast<int>(std::min<size_t>(description.chunkPointsNumber, target - computed[i]));
+            auto buffer = std::make_shared<TrajectoryBuffer::TrajectoryBuffer>(requested);
+            int written = DynamicSystemWrapper_n::computeNormalized(system, *buffer, points[i], requested,
+                                                                    description.timeDelta,
+                                                                    description.constants,
+                                                                    description.normalizeConstant);
+            computed[i] += written;
+            finished[i] = written < requested;
+
+            if (!pushChunk({runId, i, locusNumber, buffer, 0, static_cast<size_t>(written), finished[i]}, token)) {
+                return;
+            }
+        }
 
-        emit updater(std::move(buffer));
+        if (idle) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+}
+
+void CountPointsTask::run(const JobSystem::CancellationToken &token) {
+    if (description.live) {
+        runLive(token);
+        return;
+    }
+
+    const DynamicSystems::DynamicSystem &system = *description.system;
+    const size_t locusNumber = description.startPoints.size();
+
+    std::vector<std::string> keys;
+    std::vector<std::shared_ptr<TrajectoryBuffer::TrajectoryBuffer>> buffers(locusNumber);
+    std::vector<Model::Point> points = description.startPoints;
+
+    std::vector<bool> finished(locusNumber, false);
+    size_t finishedNumber = 0;
+    size_t computedNumber = 0;
+    const size_t requiredNumber = locusNumber * description.pointsNumber;
+
+    for (size_t i = 0; i < locusNumber; i++) {
+        keys.push_back(RunDescription::getTrajectoryKey(description, i));
+
+        /* A disk hit is a read-only mapping of the file, which goes to the viewer without a copy. */
+        auto cached = cache.find(keys[i]);
+        if (cached == nullptr) {
+            cached = diskCache.find(keys[i]);
+            if (cached != nullptr) {
+                cache.insert(keys[i], cached);
+            }
+        }
+        if (cached != nullptr) {
+            finished[i] = true;
+            finishedNumber++;
+            computedNumber += description.pointsNumber;
+
+            if (!pushChunk({runId, i, locusNumber, cached, 0, cached->size(), true}, token)) {
+                return;
+            }
+        } else {
+            buffers[i] = std::make_shared<TrajectoryBuffer::TrajectoryBuffer>(description.pointsNumber);
+        }
+    }
+    token.setProgress(static_cast<float>(computedNumber) / requiredNumber);
+
+    /* Loci advance chunk by chunk in turn, so that the displayed time can follow all of them at once. */
+    while (finishedNumber < locusNumber) {
+        for (size_t i = 0; i < locusNumber; i++) {
+            if (finished[i]) {
+                continue;
+            }
+            if (token.isCancelled()) {
+                return;
+            }
+
+            TrajectoryBuffer::TrajectoryBuffer &buffer = *buffers[i];
+            size_t offset = buffer.size();
+            int requested = static_cast<int>(std::min<size_t>(description.chunkPointsNumber,
+                                                              buffer.capacity() - buffer.size()));
+            int written = DynamicSystemWrapper_n::computeNormalized(system, buffer, points[i], requested,
+                                                                    description.timeDelta,
+                                                                    description.constants,
+                                                                    description.normalizeConstant);
+            bool last = written < requested || buffer.size() == buffer.capacity();
+            if (last) {
+                finished[i] = true;
+                finishedNumber++;
+                computedNumber += buffer.capacity() - buffer.size();
+                cache.insert(keys[i], buffers[i]);
+                diskCache.store(keys[i], *buffers[i]);
+            }
+            computedNumber += written;
+            token.setProgress(static_cast<float>(computedNumber) / requiredNumber);
+
+            if (!pushChunk({runId, i, locusNumber, buffers[i], offset, static_cast<size_t>(written), last}, token)) {
+                return;
+            }
+        }
     }
 }
 
@@ -179,12 +350,39 @@ void Window::addNewConstant(const std::string_view &name, long double initValue)
 }
 
 void Window::slot_restart_button() {
+    RunDescription::RunDescription description;
+    try {
+        description = captureRunDescription();
+    } catch (const Parser::ParserException &exception) {
+        QMessageBox::warning(this, "Invalid system", exception.what());
+        return;
+    }
+
+    currentRunId++;
     ui->pointsViewer->clearAll();
-    (*task)();
+
+    liveMode = description.live;
+    displayedTime = 0;
+    if (liveMode) {
+        ui->pointsViewer->setRingSize(prefs.visualization.tailPointsNumber, CountPointsTask::LIVE_LEAD_POINTS);
+    }
+
+    trajectoryCache.setMemoryBudget(static_cast<size_t>(prefs.model.cacheMemoryBudget) << 20);
+    trajectoryDiskCache.setDiskBudget(static_cast<size_t>(prefs.model.diskCacheBudget) << 20);
+
+    countPointsJob.cancel();
+    countPointsJob = workerPool.submit([description = std::move(description), runId = currentRunId.load(),
+                                        &chunks = computedChunks, &cache = trajectoryCache,
+                                        &diskCache = trajectoryDiskCache, &time = displayedTime]
+                                       (const JobSystem::CancellationToken &token) {
+        CountPointsTask(description, runId, chunks, cache, diskCache, time).run(token);
+    }, JobSystem::Priority::High);
+
+    afterCountPointsUIUpdate();
 }
 
 void Window::slot_model_selection(QString currentModel) {
-    DynamicSystemWrapper &system = dynamicSystems.at(currentModel);
+    const DynamicSystemWrapper &system = *dynamicSystems.at(currentModel);
     insertConstants(system.getInterestingConstants());
     bool readOnly = ui->modelsComboBox->currentText() != "Custom system";
     insertExpressions(system.getFormulae(), readOnly);
@@ -193,7 +391,7 @@ void Window::slot_model_selection(QString currentModel) {
 void Window::slot_constants_selection(QString currentConstants) {
     removeAllFromLayout(ui->constantsHolderLayout);
 
-    DynamicSystemWrapper &system = dynamicSystems.at(ui->modelsComboBox->currentText());
+    const DynamicSystemWrapper &system = *dynamicSystems.at(ui->modelsComboBox->currentText());
     auto goodParams = system.getInterestingConstants();
 
     for (auto&[name, params] : goodParams) {
@@ -208,8 +406,15 @@ void Window::slot_constants_selection(QString currentConstants) {
 }
 
 void Window::slot_time_slider(int timeValue_) {
+    size_t pointsPerStep = prefs.model.pointsNumber / ui->progressSlider->maximum();
+    size_t frontier = ui->pointsViewer->computedPointsNumber();
+    if (pointsPerStep * timeValue_ > frontier) {
+        ui->progressSlider->setValue(static_cast<int>(frontier / pointsPerStep));
+        return;
+    }
+
     timeValue = timeValue_;
-    ui->pointsViewer->setCurrentTime((prefs.model.pointsNumber / ui->progressSlider->maximum()) * timeValue);
+    ui->pointsViewer->setCurrentTime(pointsPerStep * timeValue);
 }
 
 void Window::slot_pause_button() {
@@ -226,12 +431,47 @@ void Window::slot_open_preferences() {
     windowPreferences->show();
 }
 
+/* Timed as a whole for the frame statistics. */
 void Window::updateSlider() {
-    if (!pauseState && timeValue <= prefs.model.pointsNumber) {
-        ui->progressSlider->setValue(timeValue += prefs.controller.deltaTimePerStep);
-        ui->pointsViewer->setCurrentTime((prefs.model.pointsNumber / ui->progressSlider->maximum()) * timeValue);
+    QElapsedTimer timer;
+    timer.start();
+
+    consumeComputedChunks();
+    updateComputationState();
+
+    if (prefs.controller.preferencesChanged) {
+        ui->pointsViewer->setPreferences(&prefs);
+        prefs.controller.preferencesChanged = false;
+    }
+    advanceSlider();
+
+    ui->pointsViewer->setSliderTime(static_cast<double>(timer.nsecsElapsed()) / 1e6);
+}
+
+void Window::advanceSlider() {
+    /* Time advances by the wall clock, however late the timer fires, and never past the computed points. */
+    size_t steps = static_cast<size_t>(sliderClock.restart()) * prefs.controller.deltaTimePerStep;
+    size_t pointsPerStep = prefs.model.pointsNumber / ui->progressSlider->maximum();
+    size_t frontier = ui->pointsViewer->computedPointsNumber();
+    if (pauseState) {
+        return;
+    }
+
+    if (liveMode) {
+        size_t nextTime = std::min(displayedTime.load() + pointsPerStep * steps, frontier);
+        if (nextTime > displayedTime.load()) {
+            displayedTime = nextTime;
+            ui->pointsViewer->setCurrentTime(nextTime);
+        }
+        return;
+    }
+
+    size_t lastTimeValue = std::min(frontier / pointsPerStep, static_cast<size_t>(ui->progressSlider->maximum()));
+    int nextTimeValue = static_cast<int>(std::min(timeValue + steps, lastTimeValue));
+    if (nextTimeValue > timeValue) {
+        ui->progressSlider->setValue(timeValue = nextTimeValue);
+        ui->pointsViewer->setCurrentTime(pointsPerStep * timeValue);
     }
-    ui->pointsViewer->repaint();
 }
 
 void Window::updateVideoRecordingState() {
@@ -264,8 +504,9 @@ void Window::updateVideoRecordingState() {
     } else {
         ui->videoRecordingButton->setEnabled(false);
 
-        auto changeProgress = [&bar = ui->videoRecordingProgress](int progress) {
-            bar->setValue(progress);
+        /* Called from the render thread, so the value is set through the event loop of the bar. */
+        auto changeProgress = [bar = ui->videoRecordingProgress](int progress) {
+            QMetaObject::invokeMethod(bar, "setValue", Qt::QueuedConnection, Q_ARG(int, progress));
         };
 
         ui->pointsViewer->endVideoRecording(changeProgress);
@@ -279,6 +520,9 @@ void Window::updateVideoRecordingState() {
 }
 
 Window::~Window() {
+    countPointsJob.cancel();
+    countPointsJob.wait();
+
     removeAllFromLayout(ui->constantsHolderLayout);
 
     delete windowPreferences;
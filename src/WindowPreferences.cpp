@@ -46,6 +46,9 @@ void WindowPreferences::setCurrentStateInUI() {
     ui->xCoordValue->setValue(prefs->model.startPoint.x);
     ui->yCoordValue->setValue(prefs->model.startPoint.y);
     ui->zCoordValue->setValue(prefs->model.startPoint.z);
+    ui->cacheMemoryValue->setValue(prefs->model.cacheMemoryBudget);
+    ui->diskCacheValue->setValue(prefs->model.diskCacheBudget);
+    ui->liveModeCheckBox->setCheckState(prefs->model.liveMode ? Qt::CheckState::Checked : Qt::CheckState::Unchecked);
 
 /* Camera settings */
     ui->sensitivitySlider->setValue((prefs->camera.sensitivity - 0.0005) / (0.03 - 0.0005) * 100);
@@ -65,10 +68,22 @@ void WindowPreferences::setCurrentStateInUI() {
     } else {
         ui->arcadeModeCheckBox->setCheckState(Qt::CheckState::Unchecked);
     }
+    ui->densityModeCheckBox->setCheckState(prefs->visualization.densityMode ? Qt::CheckState::Checked :
+                                                                              Qt::CheckState::Unchecked);
+    ui->feedbackTrailsCheckBox->setCheckState(prefs->visualization.feedbackTrails ? Qt::CheckState::Checked :
+                                                                                    Qt::CheckState::Unchecked);
+    ui->instancedHeadsCheckBox->setCheckState(prefs->visualization.instancedHeads ? Qt::CheckState::Checked :
+                                                                                    Qt::CheckState::Unchecked);
+    ui->statisticsOverlayCheckBox->setCheckState(prefs->visualization.statisticsOverlay ? Qt::CheckState::Checked :
+                                                                                          Qt::CheckState::Unchecked);
+    ui->adaptiveQualityCheckBox->setCheckState(prefs->visualization.adaptiveQuality ? Qt::CheckState::Checked :
+                                                                                      Qt::CheckState::Unchecked);
 
 /* Camera settings */
     ui->videoWidthValue->setValue(prefs->video.width);
     ui->videoHeightValue->setValue(prefs->video.height);
+    ui->posterWidthValue->setValue(prefs->video.posterWidth);
+    ui->posterHeightValue->setValue(prefs->video.posterHeight);
 }
 
 void WindowPreferences::setStateFromUI() {
@@ -80,6 +95,9 @@ void WindowPreferences::setStateFromUI() {
     prefs->model.startPoint.x        = ui->xCoordValue->value();
     prefs->model.startPoint.y        = ui->yCoordValue->value();
     prefs->model.startPoint.z        = ui->zCoordValue->value();
+    prefs->model.cacheMemoryBudget   = ui->cacheMemoryValue->value();
+    prefs->model.diskCacheBudget     = ui->diskCacheValue->value();
+    prefs->model.liveMode            = ui->liveModeCheckBox->checkState() == Qt::CheckState::Checked;
 
 /* Camera settings */
     prefs->camera.speed       = 0.05 + ui->speedMoveSlider->value() / 100.0 * (0.3 - 0.05);
@@ -101,10 +119,17 @@ void WindowPreferences::setStateFromUI() {
     } else {
         prefs->disableArcadeMode();
     }
+    prefs->visualization.densityMode = ui->densityModeCheckBox->checkState() == Qt::CheckState::Checked;
+    prefs->visualization.feedbackTrails = ui->feedbackTrailsCheckBox->checkState() == Qt::CheckState::Checked;
+    prefs->visualization.instancedHeads = ui->instancedHeadsCheckBox->checkState() == Qt::CheckState::Checked;
+    prefs->visualization.statisticsOverlay = ui->statisticsOverlayCheckBox->checkState() == Qt::CheckState::Checked;
+    prefs->visualization.adaptiveQuality = ui->adaptiveQualityCheckBox->checkState() == Qt::CheckState::Checked;
 
 /* Camera settings */
     prefs->video.width = ui->videoWidthValue->value();
     prefs->video.height = ui->videoHeightValue->value();
+    prefs->video.posterWidth = ui->posterWidthValue->value();
+    prefs->video.posterHeight = ui->posterHeightValue->value();
 
     prefs->controller.preferencesChanged = true;
 }
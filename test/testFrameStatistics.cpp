@@ -0,0 +1,60 @@
+#include <sstream>
+
+#include "gtest/gtest.h"
+#include "FrameStatistics.hpp"
+
+namespace {
+
+using FrameStatistics::Section;
+
+FrameStatistics::FrameTimes getTimes(double time, double draw, double gpuDraw) {
+    FrameStatistics::FrameTimes times;
+    times.time = time;
+    times.cpu[static_cast<size_t>(Section::Draw)] = draw;
+    times.gpu[static_cast<size_t>(Section::Draw)] = gpuDraw;
+    return times;
+}
+
+} //namespace
+
+TEST(frameStatistics, dropsOldestFramesBeyondCapacity) {
+    FrameStatistics::FrameStatistics statistics(2);
+
+    statistics.add(getTimes(0, 1, 1));
+    statistics.add(getTimes(16, 2, 2));
+    statistics.add(getTimes(32, 3, 3));
+
+    ASSERT_EQ(statistics.size(), 2u);
+    EXPECT_EQ(statistics[0].time, 16);
+    EXPECT_EQ(statistics[1].time, 32);
+}
+
+TEST(frameStatistics, meanSkipsSectionsThatDidNotRun) {
+    FrameStatistics::FrameStatistics statistics(16);
+
+    statistics.add(getTimes(0, 10, -1));
+    statistics.add(getTimes(16, 2, 4));
+    statistics.add(getTimes(32, 4, -1));
+
+    auto mean = statistics.getMean(2);
+    EXPECT_DOUBLE_EQ(mean.time, 32);
+    EXPECT_DOUBLE_EQ(mean.cpu[static_cast<size_t>(Section::Draw)], 3);
+    EXPECT_DOUBLE_EQ(mean.gpu[static_cast<size_t>(Section::Draw)], 4);
+    EXPECT_LT(mean.cpu[static_cast<size_t>(Section::Camera)], 0);
+}
+
+TEST(frameStatistics, writesCsvAndJson) {
+    FrameStatistics::FrameStatistics statistics(16);
+    statistics.add(getTimes(16, 2.5, -1));
+
+    std::ostringstream csv;
+    statistics.writeCsv(csv);
+    EXPECT_EQ(csv.str(),
+              "time,cpu_camera,cpu_slider,cpu_clear,cpu_draw,cpu_readback,cpu_frame,"
+              "gpu_camera,gpu_slider,gpu_clear,gpu_draw,gpu_readback,gpu_frame\n"
+              "16,,,,2.5,,,,,,,,\n");
+
+    std::ostringstream json;
+    statistics.writeJson(json);
+    EXPECT_EQ(json.str(), "[\n  {\"time\": 16, \"cpu\": {\"draw\": 2.5}, \"gpu\": {}}\n]\n");
+}
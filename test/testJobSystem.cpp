@@ -0,0 +1,107 @@
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "JobSystem.hpp"
+
+TEST(jobSystem, runsJobsAndReportsProgress) {
+    JobSystem::WorkerPool pool(2);
+
+    std::atomic<int> sum{0};
+    std::vector<JobSystem::JobHandle> handles;
+    for (int i = 1; i <= 100; i++) {
+        handles.push_back(pool.submit([&sum, i](const JobSystem::CancellationToken &token) {
+            sum += i;
+            token.setProgress(1);
+        }));
+    }
+    for (auto &handle : handles) {
+        handle.wait();
+        EXPECT_TRUE(handle.isFinished());
+        EXPECT_EQ(handle.progress(), 1);
+        EXPECT_EQ(handle.error(), nullptr);
+    }
+    EXPECT_EQ(sum.load(), 5050);
+}
+
+TEST(jobSystem, cancelsRunningJob) {
+    JobSystem::WorkerPool pool(1);
+
+    std::atomic<bool> started{false};
+    auto handle = pool.submit([&started](const JobSystem::CancellationToken &token) {
+        started = true;
+        while (!token.isCancelled()) {
+            std::this_thread::yield();
+        }
+    });
+    while (!started) {
+        std::this_thread::yield();
+    }
+
+    auto cancelTime = std::chrono::steady_clock::now();
+    handle.cancel();
+    handle.wait();
+
+    EXPECT_TRUE(handle.isCancelled());
+    EXPECT_LT(std::chrono::steady_clock::now() - cancelTime, std::chrono::seconds(1));
+}
+
+TEST(jobSystem, skipsJobsCancelledBeforeStart) {
+    JobSystem::WorkerPool pool(1);
+
+    std::atomic<bool> release{false};
+    auto blocker = pool.submit([&release](const JobSystem::CancellationToken &) {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+
+    bool executed = false;
+    auto handle = pool.submit([&executed](const JobSystem::CancellationToken &) {
+        executed = true;
+    });
+    handle.cancel();
+    release = true;
+    handle.wait();
+
+    EXPECT_FALSE(executed);
+}
+
+TEST(jobSystem, higherPriorityRunsFirst) {
+    JobSystem::WorkerPool pool(1);
+
+    std::atomic<bool> release{false};
+    pool.submit([&release](const JobSystem::CancellationToken &) {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+
+    std::vector<int> order;
+    auto low = pool.submit([&order](const JobSystem::CancellationToken &) {
+        order.push_back(0);
+    }, JobSystem::Priority::Low);
+    auto high = pool.submit([&order](const JobSystem::CancellationToken &) {
+        order.push_back(2);
+    }, JobSystem::Priority::High);
+    release = true;
+    low.wait();
+    high.wait();
+
+    EXPECT_EQ(order, (std::vector<int>{2, 0}));
+}
+
+TEST(jobSystem, capturesExceptions) {
+    JobSystem::WorkerPool pool(1);
+
+    auto handle = pool.submit([](const JobSystem::CancellationToken &) {
+        throw std::runtime_error("failure");
+    });
+    handle.wait();
+
+    ASSERT_NE(handle.error(), nullptr);
+    EXPECT_THROW(std::rethrow_exception(handle.error()), std::runtime_error);
+}
@@ -0,0 +1,60 @@
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "LockFreeQueue.hpp"
+
+TEST(lockFreeQueue, fifoOrderAndCapacity) {
+    LockFreeQueue::LockFreeQueue<int> queue(4);
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(int{i}));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+
+    int value;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(lockFreeQueue, manyProducersOneConsumer) {
+    constexpr int producersNumber = 4;
+    constexpr int valuesPerProducer = 100'000;
+
+    LockFreeQueue::LockFreeQueue<int> queue(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producersNumber; p++) {
+        producers.emplace_back([&queue, p]() {
+            for (int i = 0; i < valuesPerProducer; i++) {
+                while (!queue.tryPush(p * valuesPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> lastSeen(producersNumber, -1);
+    long long sum = 0;
+    for (int received = 0; received < producersNumber * valuesPerProducer;) {
+        int value;
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / valuesPerProducer;
+        EXPECT_LT(lastSeen[producer], value % valuesPerProducer);
+        lastSeen[producer] = value % valuesPerProducer;
+        sum += value;
+        received++;
+    }
+    for (auto &producer : producers) {
+        producer.join();
+    }
+
+    long long total = static_cast<long long>(producersNumber) * valuesPerProducer;
+    EXPECT_EQ(sum, total * (total - 1) / 2);
+}
@@ -0,0 +1,30 @@
+#include <limits>
+
+#include "gtest/gtest.h"
+#include "LocusLayout.hpp"
+
+TEST(locusLayout, levelSizesRoundUp) {
+    EXPECT_EQ(LocusLayout::getLevelSize(1000, 0), 1000u);
+    EXPECT_EQ(LocusLayout::getLevelSize(1000, 1), 250u);
+    EXPECT_EQ(LocusLayout::getLevelSize(1001, 1), 251u);
+    EXPECT_EQ(LocusLayout::getLevelSize(1, 3), 1u);
+    EXPECT_EQ(LocusLayout::getLevelSize(0, 2), 0u);
+}
+
+TEST(locusLayout, levelsFollowEachOther) {
+    EXPECT_EQ(LocusLayout::getLevelOffset(1024, 0), 0u);
+    EXPECT_EQ(LocusLayout::getLevelOffset(1024, 1), 1024u);
+    EXPECT_EQ(LocusLayout::getLevelOffset(1024, LocusLayout::LOD_LEVELS), 1024u + 256 + 64 + 16);
+}
+
+TEST(locusLayout, lociStopAtVertexLimit) {
+    EXPECT_EQ(LocusLayout::getMaxLocusNumber(1000, 5, 4500), 4u);
+    EXPECT_EQ(LocusLayout::getMaxLocusNumber(1000, 3, 4500), 3u);
+    EXPECT_EQ(LocusLayout::getMaxLocusNumber(5000, 3, 4500), 0u);
+}
+
+TEST(locusLayout, emptyFirstChunkFitsAnyNumberOfLoci) {
+    size_t regionSize = LocusLayout::getLevelOffset(0, LocusLayout::LOD_LEVELS);
+    EXPECT_EQ(regionSize, 0u);
+    EXPECT_EQ(LocusLayout::getMaxLocusNumber(regionSize, 100, std::numeric_limits<int>::max()), 100u);
+}
@@ -0,0 +1,67 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "LocusProgress.hpp"
+
+namespace {
+
+std::vector<float> getPoints(size_t count) {
+    std::vector<float> points(3 * count);
+    for (size_t i = 0; i < points.size(); i++) {
+        points[i] = static_cast<float>(i);
+    }
+    return points;
+}
+
+} //namespace
+
+TEST(locusProgress, pointsWaitUntilUploaded) {
+    LocusProgress::LocusProgress progress;
+    auto points = getPoints(10);
+
+    progress.append(points.data(), 10, false);
+    EXPECT_EQ(progress.size(), 0u);
+    EXPECT_EQ(progress.getPendingNumber(), 10u);
+
+    progress.markUploaded(4);
+    EXPECT_EQ(progress.size(), 4u);
+    EXPECT_EQ(progress.getPendingNumber(), 6u);
+    EXPECT_EQ(progress.getPendingPoints()[0], points[3 * 4]);
+    EXPECT_FALSE(progress.isComplete());
+}
+
+TEST(locusProgress, lastPointsCompleteOnceUploaded) {
+    LocusProgress::LocusProgress progress;
+    auto points = getPoints(10);
+
+    progress.append(points.data(), 10, true);
+    EXPECT_FALSE(progress.isComplete());
+
+    progress.markUploaded(10);
+    EXPECT_TRUE(progress.isComplete());
+    EXPECT_EQ(progress.size(), 10u);
+}
+
+TEST(locusProgress, emptyLastChunkCompletes) {
+    LocusProgress::LocusProgress progress;
+
+    progress.append(nullptr, 0, true);
+
+    EXPECT_TRUE(progress.isComplete());
+    EXPECT_EQ(progress.size(), 0u);
+}
+
+/* A refused chunk ends its locus while the points of an unfinished block still wait. */
+TEST(locusProgress, finishDropsPendingPoints) {
+    LocusProgress::LocusProgress progress;
+    auto points = getPoints(1500);
+
+    progress.append(points.data(), 1500, false);
+    progress.markUploaded(1024);
+    progress.finish();
+
+    EXPECT_TRUE(progress.isComplete());
+    EXPECT_EQ(progress.size(), 1024u);
+    EXPECT_EQ(progress.getPendingNumber(), 0u);
+    EXPECT_EQ(progress.getAppendedNumber(), 1024u);
+}
@@ -0,0 +1,61 @@
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "PngStreamWriter.hpp"
+
+namespace {
+
+constexpr const char *FILE_NAME = "testPngStreamWriter.png";
+
+std::vector<uint8_t> readRgb(const char *fileName, png_uint_32 &width, png_uint_32 &height) {
+    png_image image{};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, fileName)) {
+        return {};
+    }
+    image.format = PNG_FORMAT_RGB;
+    std::vector<uint8_t> pixels(PNG_IMAGE_SIZE(image));
+    png_image_finish_read(&image, nullptr, pixels.data(), 0, nullptr);
+    width = image.width;
+    height = image.height;
+    return pixels;
+}
+
+} //namespace
+
+TEST(pngStreamWriter, writesRowsFromTheTop) {
+    std::vector<uint8_t> top = {255, 0, 0, 0, 255, 0, 0, 0, 255};
+    std::vector<uint8_t> bottom = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    PngStreamWriter::PngStreamWriter writer;
+    writer.open(FILE_NAME, 3, 2);
+    writer.writeRow(top.data());
+    writer.writeRow(bottom.data());
+    writer.close();
+
+    png_uint_32 width = 0;
+    png_uint_32 height = 0;
+    auto pixels = readRgb(FILE_NAME, width, height);
+    std::remove(FILE_NAME);
+
+    EXPECT_EQ(width, 3u);
+    EXPECT_EQ(height, 2u);
+    std::vector<uint8_t> expected = top;
+    expected.insert(expected.end(), bottom.begin(), bottom.end());
+    EXPECT_EQ(pixels, expected);
+}
+
+TEST(pngStreamWriter, refusesIncompleteImages) {
+    std::vector<uint8_t> row(3 * 4);
+
+    PngStreamWriter::PngStreamWriter writer;
+    writer.open(FILE_NAME, 4, 2);
+    writer.writeRow(row.data());
+    EXPECT_THROW(writer.close(), std::logic_error);
+    EXPECT_FALSE(writer.isOpen());
+    std::remove(FILE_NAME);
+
+    EXPECT_THROW(writer.open("no/such/directory/image.png", 4, 2), std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "QualityGovernor.hpp"
+
+namespace {
+
+using QualityGovernor::Knob;
+
+/* Returns the adjustments made while feeding framesNumber frames of the given time. */
+std::vector<QualityGovernor::Adjustment> feed(QualityGovernor::QualityGovernor &governor,
+                                              double milliseconds, size_t framesNumber) {
+    std::vector<QualityGovernor::Adjustment> adjustments;
+    for (size_t i = 0; i < framesNumber; i++) {
+        if (auto adjustment = governor.addFrame(milliseconds)) {
+            adjustments.push_back(*adjustment);
+        }
+    }
+    return adjustments;
+}
+
+} //namespace
+
+TEST(qualityGovernor, lowersKnobsInOrderWhileSlow) {
+    QualityGovernor::QualityGovernor governor(16);
+
+    auto adjustments = feed(governor, 30, 1000);
+
+    ASSERT_EQ(adjustments.size(), 3 * QualityGovernor::QualityGovernor::MAX_LEVEL);
+    EXPECT_EQ(adjustments.front().knob, Knob::Subdivision);
+    EXPECT_TRUE(adjustments.front().lowered);
+    EXPECT_EQ(adjustments.back().knob, Knob::PointBudget);
+    EXPECT_EQ(governor.getLevel(Knob::PointBudget), QualityGovernor::QualityGovernor::MAX_LEVEL);
+}
+
+TEST(qualityGovernor, holdsInsideTheHysteresisBand) {
+    QualityGovernor::QualityGovernor governor(16);
+    feed(governor, 30, 20);
+    ASSERT_EQ(governor.getLevel(Knob::Subdivision), 1u);
+
+    EXPECT_TRUE(feed(governor, 13, 1000).empty());
+    EXPECT_TRUE(feed(governor, 14, 5).empty());
+}
+
+TEST(qualityGovernor, raisesKnobsInReverseOrderWhileFast) {
+    QualityGovernor::QualityGovernor governor(16);
+    feed(governor, 30, 1000);
+
+    auto adjustments = feed(governor, 2, 200);
+
+    ASSERT_EQ(adjustments.size(), 1u);
+    EXPECT_EQ(adjustments.front().knob, Knob::PointBudget);
+    EXPECT_FALSE(adjustments.front().lowered);
+}
+
+TEST(qualityGovernor, appliesLevelsToRequestedSettings) {
+    QualityGovernor::QualityGovernor governor(16);
+    QualityGovernor::Settings requested{8, 0.15f, 1.0f, 100};
+    EXPECT_EQ(governor.describe(), "full quality");
+
+    feed(governor, 30, 1000);
+    auto settings = governor.apply(requested);
+
+    EXPECT_EQ(settings.splineSegments, 1);
+    EXPECT_FLOAT_EQ(settings.interpolationDistance, 1.2f);
+    EXPECT_FLOAT_EQ(settings.lodPixelError, 8.0f);
+    EXPECT_EQ(settings.tailPointsNumber, 25u);
+    EXPECT_EQ(governor.describe(), "subdivision -3, level of detail -3, point budget -3");
+}
@@ -11,7 +11,7 @@ auto getCounter(int &count) {
 int countConvergesSystems(const Model::Point &startPoint, int requiredCount, long double tau) {
     int convergesCount = 0;
 
-    auto vectorSystems = DynamicSystems::getDefaultSystems<decltype(getCounter(std::declval<int &>()))>();
+    auto vectorSystems = DynamicSystems::getDefaultSystems();
 
     for (auto &system : vectorSystems) {
         auto constantValues = system.getInterestingConstants();
@@ -55,4 +55,45 @@ TEST(model, allConstantRK4_4) {
     long double tau = 0.1;
 
     EXPECT_GE(countConvergesSystems(startPoint, requiredCount, tau), 21);
-}
\ No newline at end of file
+}
+
+TEST(model, computeBlockMatchesPerPointCompute) {
+    auto system = DynamicSystems::getDefaultSystems().front();
+    const auto &constants = system.getInterestingConstants().front().second;
+    Model::Point startPoint = {0.1, 0.2, 0.3};
+    long double tau = 0.01;
+    int requiredCount = 10'000;
+
+    std::vector<Model::Point> expected;
+    system.compute([&expected](const Model::Point &point) {
+        expected.push_back(point);
+    }, startPoint, requiredCount, tau, constants);
+    ASSERT_EQ(static_cast<int>(expected.size()), requiredCount);
+
+    std::vector<Model::Point> actual(requiredCount);
+    Model::Point current = startPoint;
+    int written = 0;
+    while (written < requiredCount) {
+        int blockSize = std::min(777, requiredCount - written);
+        ASSERT_EQ(system.computeBlock(actual.data() + written, current, blockSize, tau, constants), blockSize);
+        written += blockSize;
+    }
+
+    for (int i = 0; i < requiredCount; i++) {
+        EXPECT_EQ(actual[i].x, expected[i].x);
+        EXPECT_EQ(actual[i].y, expected[i].y);
+        EXPECT_EQ(actual[i].z, expected[i].z);
+    }
+}
+
+TEST(model, computeBlockStopsOutsideLimits) {
+    auto system = DynamicSystems::getDefaultSystems().front();
+    const std::vector<long double> constants = {-100, -100, -100};
+
+    std::vector<Model::Point> points(100'000);
+    Model::Point current = {1, 1, 1};
+    int written = system.computeBlock(points.data(), current, points.size(), 0.01, constants);
+
+    EXPECT_LT(written, static_cast<int>(points.size()));
+    EXPECT_EQ(system.computeBlock(points.data(), current, points.size(), 0.01, constants), 0);
+}
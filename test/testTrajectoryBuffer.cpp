@@ -0,0 +1,53 @@
+#include "gtest/gtest.h"
+#include "DynamicSystems/DynamicSystem.hpp"
+#include "DynamicSystemWrapper.hpp"
+#include "TrajectoryBuffer.hpp"
+
+TEST(trajectoryBuffer, convertAndNormalize) {
+    Model::Point points[] = {{8, -16, 4}, {0.8, 1.6, -2.4}};
+    float out[6];
+
+    TrajectoryBuffer::convertAndNormalize(points, 2, 8, out);
+
+    float expected[] = {1, -2, 0.5, 0.1, 0.2, -0.3};
+    for (size_t i = 0; i < 6; i++) {
+        EXPECT_NEAR(out[i], expected[i], 1e-6);
+    }
+}
+
+TEST(trajectoryBuffer, appendStopsAtCapacity) {
+    Model::Point points[] = {{1, 2, 3}, {4, 5, 6}, {7, 8, 9}};
+    TrajectoryBuffer::TrajectoryBuffer buffer(2);
+
+    buffer.append(points, 3, 1);
+
+    EXPECT_EQ(buffer.size(), 2u);
+    EXPECT_EQ(buffer.data()[5], 6);
+}
+
+TEST(trajectoryBuffer, computeNormalizedMatchesCompute) {
+    auto system = DynamicSystems::getDefaultSystems().front();
+    const auto &constants = system.getInterestingConstants().front().second;
+    Model::Point startPoint = {0.1, 0.2, 0.3};
+    int requiredCount = 5'000;
+    float normalizeConstant = 8;
+
+    std::vector<float> expected;
+    system.compute([&expected, normalizeConstant](const Model::Point &point) {
+        expected.push_back(static_cast<float>(point.x) / normalizeConstant);
+        expected.push_back(static_cast<float>(point.y) / normalizeConstant);
+        expected.push_back(static_cast<float>(point.z) / normalizeConstant);
+    }, startPoint, requiredCount, 0.01, constants);
+
+    TrajectoryBuffer::TrajectoryBuffer buffer(requiredCount);
+    Model::Point current = startPoint;
+    while (buffer.size() < buffer.capacity()) {
+        ASSERT_GT(DynamicSystemWrapper_n::computeNormalized(system, buffer, current, 1'000, 0.01,
+                                                            constants, normalizeConstant), 0);
+    }
+
+    ASSERT_EQ(buffer.size() * 3, expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_FLOAT_EQ(buffer.data()[i], expected[i]);
+    }
+}
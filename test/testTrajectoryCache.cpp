@@ -0,0 +1,87 @@
+#include <memory>
+
+#include "gtest/gtest.h"
+#include "DynamicSystems/DynamicSystem.hpp"
+#include "RunDescription.hpp"
+#include "TrajectoryCache.hpp"
+
+namespace {
+
+constexpr size_t POINT_SIZE = 3 * sizeof(float);
+
+std::shared_ptr<const TrajectoryBuffer::TrajectoryBuffer> getBuffer(size_t pointsNumber) {
+    return std::make_shared<const TrajectoryBuffer::TrajectoryBuffer>(pointsNumber);
+}
+
+RunDescription::RunDescription getDescription() {
+    auto system = std::make_shared<const DynamicSystems::DynamicSystem>(DynamicSystems::getDefaultSystems().front());
+
+    RunDescription::RunDescription description;
+    description.system = system;
+    description.constants = system->getInterestingConstants().front().second;
+    description.startPoints = {{0.1, 0.2, 0.3}, {0.15, 0.25, 0.35}};
+    description.pointsNumber = 1000;
+    description.chunkPointsNumber = 100;
+    description.timeDelta = 0.01;
+    description.integrator = Model::Integrator::RungeKutta4;
+    description.normalizeConstant = 8;
+    return description;
+}
+
+} //namespace
+
+TEST(trajectoryCache, evictsLeastRecentlyUsed) {
+    TrajectoryCache::TrajectoryCache cache(3 * 100 * POINT_SIZE);
+
+    cache.insert("a", getBuffer(100));
+    cache.insert("b", getBuffer(100));
+    cache.insert("c", getBuffer(100));
+    EXPECT_NE(cache.find("a"), nullptr);
+
+    cache.insert("d", getBuffer(100));
+
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(cache.find("b"), nullptr);
+    EXPECT_NE(cache.find("c"), nullptr);
+    EXPECT_NE(cache.find("d"), nullptr);
+    EXPECT_EQ(cache.memoryUsage(), 3 * 100 * POINT_SIZE);
+}
+
+TEST(trajectoryCache, respectsBudgetChanges) {
+    TrajectoryCache::TrajectoryCache cache(10 * POINT_SIZE);
+
+    cache.insert("huge", getBuffer(11));
+    EXPECT_EQ(cache.find("huge"), nullptr);
+
+    cache.insert("a", getBuffer(5));
+    cache.insert("b", getBuffer(5));
+    cache.setMemoryBudget(5 * POINT_SIZE);
+
+    EXPECT_EQ(cache.find("a"), nullptr);
+    EXPECT_NE(cache.find("b"), nullptr);
+}
+
+TEST(trajectoryCache, keysDependOnEverySetting) {
+    auto description = getDescription();
+    auto key = RunDescription::getTrajectoryKey(description, 0);
+
+    EXPECT_EQ(key, RunDescription::getTrajectoryKey(getDescription(), 0));
+    EXPECT_NE(key, RunDescription::getTrajectoryKey(description, 1));
+
+    auto changed = description;
+    changed.constants[0] += 1e-12;
+    EXPECT_NE(key, RunDescription::getTrajectoryKey(changed, 0));
+
+    changed = description;
+    changed.timeDelta = 0.02;
+    EXPECT_NE(key, RunDescription::getTrajectoryKey(changed, 0));
+
+    changed = description;
+    changed.pointsNumber++;
+    EXPECT_NE(key, RunDescription::getTrajectoryKey(changed, 0));
+
+    changed = description;
+    changed.chunkPointsNumber++;
+    EXPECT_EQ(key, RunDescription::getTrajectoryKey(changed, 0));
+}
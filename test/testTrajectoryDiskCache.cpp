@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "TrajectoryDiskCache.hpp"
+
+namespace {
+
+constexpr size_t POINTS_NUMBER = 100;
+
+/* A fresh directory that is removed with everything in it. */
+class TemporaryDirectory final {
+public:
+    TemporaryDirectory() {
+        std::string pattern = (std::filesystem::temp_directory_path() / "trajectoryDiskCacheXXXXXX").string();
+        if (mkdtemp(pattern.data()) != nullptr) {
+            directory = pattern;
+        }
+    }
+    ~TemporaryDirectory() {
+        std::error_code error;
+        if (!directory.empty()) {
+            std::filesystem::remove_all(directory, error);
+        }
+    }
+
+    TemporaryDirectory(const TemporaryDirectory &)            = delete;
+    TemporaryDirectory(TemporaryDirectory &&)                 = delete;
+    TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+    TemporaryDirectory &operator=(TemporaryDirectory &&)      = delete;
+
+    bool isValid() const {
+        return !directory.empty();
+    }
+
+    const std::string &path() const {
+        return directory;
+    }
+
+private:
+    std::string directory;
+};
+
+TrajectoryBuffer::TrajectoryBuffer getBuffer(float offset) {
+    std::vector<Model::Point> points;
+    for (size_t i = 0; i < POINTS_NUMBER; i++) {
+        points.push_back({offset + i, offset - i, offset * i});
+    }
+    TrajectoryBuffer::TrajectoryBuffer buffer(POINTS_NUMBER);
+    buffer.append(points.data(), points.size(), 1);
+    return buffer;
+}
+
+std::vector<std::string> getFiles(const TemporaryDirectory &directory) {
+    std::vector<std::string> files;
+    for (const auto &entry : std::filesystem::directory_iterator(directory.path())) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path().filename().string());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+std::string getFilePath(const TemporaryDirectory &directory, const std::string &name) {
+    return directory.path() + "/" + name;
+}
+
+/* The only file of a cache that stored key alone. */
+std::string getFileName(const std::string &key) {
+    TemporaryDirectory directory;
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+    cache.store(key, getBuffer(0));
+    auto files = getFiles(directory);
+    return files.empty() ? std::string() : files.front();
+}
+
+void setAge(const std::string &path, int seconds) {
+    auto time = std::filesystem::file_time_type::clock::now() - std::chrono::seconds(seconds);
+    std::filesystem::last_write_time(path, time);
+}
+
+} //namespace
+
+TEST(trajectoryDiskCache, roundTrip) {
+    TemporaryDirectory directory;
+    ASSERT_TRUE(directory.isValid());
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+
+    auto buffer = getBuffer(1);
+    cache.store("a", buffer);
+
+    auto found = cache.find("a");
+    ASSERT_NE(found, nullptr);
+    ASSERT_EQ(found->size(), buffer.size());
+    for (size_t i = 0; i < 3 * buffer.size(); i++) {
+        EXPECT_EQ(found->data()[i], buffer.data()[i]);
+    }
+    EXPECT_EQ(cache.find("b"), nullptr);
+}
+
+TEST(trajectoryDiskCache, roundTripEmpty) {
+    TemporaryDirectory directory;
+    ASSERT_TRUE(directory.isValid());
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+
+    cache.store("a", TrajectoryBuffer::TrajectoryBuffer(0));
+
+    auto found = cache.find("a");
+    ASSERT_NE(found, nullptr);
+    EXPECT_EQ(found->size(), 0u);
+}
+
+TEST(trajectoryDiskCache, rejectsOtherKeyWithSameFileName) {
+    TemporaryDirectory directory;
+    ASSERT_TRUE(directory.isValid());
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+
+    cache.store("a", getBuffer(1));
+    ASSERT_EQ(getFiles(directory).size(), 1u);
+
+    /* Stands for a hash collision: the entry of "a" under the name "b" hashes to. */
+    std::string collidingName = getFileName("b");
+    ASSERT_FALSE(collidingName.empty());
+    std::filesystem::rename(getFilePath(directory, getFiles(directory).front()),
+                            getFilePath(directory, collidingName));
+
+    EXPECT_EQ(cache.find("b"), nullptr);
+}
+
+TEST(trajectoryDiskCache, rejectsTruncatedFile) {
+    TemporaryDirectory directory;
+    ASSERT_TRUE(directory.isValid());
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+
+    cache.store("a", getBuffer(1));
+    std::string path = getFilePath(directory, getFiles(directory).front());
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+    EXPECT_EQ(cache.find("a"), nullptr);
+}
+
+TEST(trajectoryDiskCache, rejectsCorruptHeader) {
+    TemporaryDirectory directory;
+    ASSERT_TRUE(directory.isValid());
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+
+    cache.store("a", getBuffer(1));
+    {
+        std::fstream file(getFilePath(directory, getFiles(directory).front()),
+                          std::ios::binary | std::ios::in | std::ios::out);
+        ASSERT_TRUE(file.is_open());
+        file.write("XXXX", 4);
+    }
+
+    EXPECT_EQ(cache.find("a"), nullptr);
+}
+
+TEST(trajectoryDiskCache, evictsLeastRecentlyUsedToBudget) {
+    TemporaryDirectory directory;
+    ASSERT_TRUE(directory.isValid());
+    TrajectoryDiskCache::TrajectoryDiskCache cache(directory.path(), 1 << 20);
+
+    cache.store("a", getBuffer(1));
+    std::string nameA = getFiles(directory).front();
+    cache.store("b", getBuffer(2));
+    auto files = getFiles(directory);
+    ASSERT_EQ(files.size(), 2u);
+    std::string nameB = files.front() == nameA ? files.back() : files.front();
+    auto fileSize = std::filesystem::file_size(getFilePath(directory, nameA));
+
+    /* File times are too coarse on some file systems to order writes a moment apart. */
+    setAge(getFilePath(directory, nameA), 20);
+    setAge(getFilePath(directory, nameB), 10);
+    EXPECT_NE(cache.find("a"), nullptr);
+
+    cache.setDiskBudget(static_cast<size_t>(fileSize));
+
+    EXPECT_EQ(getFiles(directory), std::vector<std::string>{nameA});
+    EXPECT_NE(cache.find("a"), nullptr);
+    EXPECT_EQ(cache.find("b"), nullptr);
+}